@@ -0,0 +1,308 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <time.h>
+#include "../include/memory.h"
+
+//Constants
+#define MIN_FRAMES 1000
+#define DEFAULT_MAX_FRAMES 100000000
+#define FRAMES_PER_RUN 100000000
+#define N_REPEATS 3
+#define BITS_PER_FRAME_WORD 64
+#define OWNER_PID 1
+#define LOADER_PID 2
+
+//Internal to memory.c, not part of memory.h
+void add_into_memory(struct memory_t **memory, uint32_t pid, uint32_t pages);
+uint32_t find_second_chance(struct memory_t *memory);
+void claim_frame(struct memory_t *memory, uint32_t frame, uint32_t pid);
+void release_frame(struct memory_t *memory, uint32_t frame);
+
+//Functions
+double now_seconds(void);
+struct memory_t *fill_memory(uint32_t n_frames);
+void reset_reference_bits(struct memory_t *memory);
+void reset_reference_array(uint32_t *reference_bit, uint32_t n_frames);
+uint32_t scalar_first_free(uint32_t *main_memory, uint32_t n_frames);
+uint32_t scalar_second_chance(uint32_t *main_memory, uint32_t *reference_bit, uint32_t n_frames,
+ uint32_t pid, uint32_t *hand);
+double time_free_scan(struct memory_t *memory, uint32_t reps, int bitmap);
+double time_second_chance(struct memory_t *memory, uint32_t *reference_bit, uint32_t reps, int bitmap);
+
+/*
+Frame scan benchmark, the word at a time ctz scans of the free and reference bitmaps
+against the per-frame loops over main_memory they replaced, at their worst case: the
+only free frame, or the only frame without a reference bit, is the last one
+!! USAGE: bench_frames [max frames]
+!! TIMES ARE PER SCAN, A FREE SCAN INCLUDES CLAIMING AND RELEASING THE FRAME, A SECOND
+!! CHANCE SCAN EXCLUDES RESETTING THE REFERENCE BITS IT CLEARED
+*/
+int main(int argc, char **argv)
+{
+    uint32_t max_frames = argc > 1 ? strtoul(argv[1], NULL, 10) : DEFAULT_MAX_FRAMES;
+
+    printf("%10s %14s %14s %8s %14s %14s %8s\n", "frames", "free ctz ns", "free loop ns", "speedup",
+     "second ctz ns", "second loop ns", "speedup");
+    fflush(stdout);
+
+    for (uint32_t n = MIN_FRAMES; n <= max_frames; n *= 10)
+    {
+        struct memory_t *memory = fill_memory(n);
+        uint32_t *reference_bit = malloc(sizeof(uint32_t) * n);
+        uint32_t reps = n < FRAMES_PER_RUN ? FRAMES_PER_RUN / n : 1;
+        double t[4];
+
+        if (!reference_bit)
+        {
+            fprintf(stderr, "Malloc failed!\n");
+            exit(1);
+        }
+        //Faults every page in before any timing
+        reset_reference_array(reference_bit, n);
+
+        //Best of a few passes each
+        for (int i = 0; i < N_REPEATS; i++)
+        {
+            double pass[4] = {time_free_scan(memory, reps, 1), time_free_scan(memory, reps, 0),
+             time_second_chance(memory, reference_bit, reps, 1),
+             time_second_chance(memory, reference_bit, reps, 0)};
+
+            for (int j = 0; j < 4; j++)
+            {
+                t[j] = (i == 0 || pass[j] < t[j]) ? pass[j] : t[j];
+            }
+        }
+
+        printf("%10"PRIu32" %14.1f %14.1f %7.1fx %14.1f %14.1f %7.1fx\n", n, t[0] * 1e9 / reps,
+         t[1] * 1e9 / reps, t[1] / t[0], t[2] * 1e9 / reps, t[3] * 1e9 / reps, t[3] / t[2]);
+        fflush(stdout);
+
+        free(reference_bit);
+        free_memory(memory);
+
+        if (n > max_frames / 10)
+        {
+            break;
+        }
+    }
+
+    return 0;
+}
+
+/*
+Reads a monotonic clock
+@return
+double, the time in Seconds
+*/
+double now_seconds(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/*
+Creates a memory with every frame but the last taken by OWNER_PID, written directly
+rather than through resident sets, which the scans never read
+@params
+n_frames, uint32_t, number of page frames
+
+@return
+struct memory_t *, the memory
+*/
+struct memory_t *fill_memory(uint32_t n_frames)
+{
+    struct memory_t *memory = init_memory(n_frames * 4);
+    uint32_t n_words = (n_frames + BITS_PER_FRAME_WORD - 1) / BITS_PER_FRAME_WORD;
+
+    for (uint32_t i = 0; i < n_frames - 1; i++)
+    {
+        memory->main_memory[i] = OWNER_PID;
+    }
+    for (uint32_t w = 0; w < n_words; w++)
+    {
+        memory->free_frames[w] = 0;
+    }
+    memory->free_frames[(n_frames - 1) / BITS_PER_FRAME_WORD] =
+     UINT64_C(1) << ((n_frames - 1) % BITS_PER_FRAME_WORD);
+    memory->n_free_pages = 1;
+
+    return memory;
+}
+
+/*
+Sets the reference bit of every frame but the last
+@params
+memory, struct memory_t *, the memory
+*/
+void reset_reference_bits(struct memory_t *memory)
+{
+    uint32_t n_words = (memory->n_total_pages + BITS_PER_FRAME_WORD - 1) / BITS_PER_FRAME_WORD;
+    uint32_t last = memory->n_total_pages - 1;
+
+    for (uint32_t w = 0; w < n_words; w++)
+    {
+        memory->reference_bits[w] = UINT64_MAX;
+    }
+    //Bits from the last frame on, including those past the end, are clear
+    memory->reference_bits[last / BITS_PER_FRAME_WORD] = (UINT64_C(1) << (last % BITS_PER_FRAME_WORD)) - 1;
+}
+
+/*
+Sets the reference bit of every frame but the last, one word per frame
+@params
+reference_bit, uint32_t *, the reference bits
+n_frames, uint32_t, number of page frames
+*/
+void reset_reference_array(uint32_t *reference_bit, uint32_t n_frames)
+{
+    for (uint32_t i = 0; i < n_frames - 1; i++)
+    {
+        reference_bit[i] = 1;
+    }
+    reference_bit[n_frames - 1] = 0;
+}
+
+/*
+Finds the lowest free frame one frame at a time
+@params
+main_memory, uint32_t *, owner of every frame, UINT32_MAX if free
+n_frames, uint32_t, number of page frames
+
+@return
+uint32_t, index of the frame, n_frames if none is free
+*/
+uint32_t scalar_first_free(uint32_t *main_memory, uint32_t n_frames)
+{
+    for (uint32_t i = 0; i < n_frames; i++)
+    {
+        if (main_memory[i] == UINT32_MAX)
+        {
+            return i;
+        }
+    }
+    return n_frames;
+}
+
+/*
+Finds the first frame, from the hand on, not owned by a pid and without a reference
+bit, one frame at a time, clearing the reference bits passed over
+!! LOOPS UNTIL A FRAME IS FOUND, ASSUMES SOME FRAME IS NOT OWNED
+@params
+main_memory, uint32_t *, owner of every frame
+reference_bit, uint32_t *, reference bit of every frame
+n_frames, uint32_t, number of page frames
+pid, uint32_t, Process ID of the loading process
+hand, uint32_t *, the clock hand, moved past the frame found
+
+@return
+uint32_t, index of the page frame
+*/
+uint32_t scalar_second_chance(uint32_t *main_memory, uint32_t *reference_bit, uint32_t n_frames,
+ uint32_t pid, uint32_t *hand)
+{
+    uint32_t i = *hand;
+
+    while (1)
+    {
+        if (main_memory[i] != pid)
+        {
+            if (reference_bit[i] == 0)
+            {
+                *hand = i + 1 < n_frames ? i + 1 : 0;
+                return i;
+            }
+            reference_bit[i] = 0;
+        }
+        i = i + 1 < n_frames ? i + 1 : 0;
+    }
+}
+
+/*
+Times finding the only free frame, then claiming and releasing it
+@params
+memory, struct memory_t *, the filled memory
+reps, uint32_t, number of scans
+bitmap, int, 1 to scan the free bitmap through add_into_memory, 0 for the per-frame loop
+
+@return
+double, the time taken by every scan in Seconds
+*/
+double time_free_scan(struct memory_t *memory, uint32_t reps, int bitmap)
+{
+    uint32_t last = memory->n_total_pages - 1;
+    double start = now_seconds();
+
+    for (uint32_t i = 0; i < reps; i++)
+    {
+        if (bitmap)
+        {
+            //Scans from the first word, as if every frame below had just been filled
+            memory->free_lo = 0;
+            add_into_memory(&memory, LOADER_PID, 1);
+        }
+        else
+        {
+            claim_frame(memory, scalar_first_free(memory->main_memory, memory->n_total_pages), LOADER_PID);
+        }
+        release_frame(memory, last);
+    }
+
+    return now_seconds() - start;
+}
+
+/*
+Times a whole turn of the clock hand, finding the last frame as the only one without a
+reference bit
+@params
+memory, struct memory_t *, the filled memory, no frame owned by the loading process
+reference_bit, uint32_t *, one word per frame reference bits, for the per-frame loop
+reps, uint32_t, number of scans
+bitmap, int, 1 for find_second_chance, 0 for the per-frame loop
+
+@return
+double, the time taken by every scan in Seconds, resetting the reference bits excluded
+*/
+double time_second_chance(struct memory_t *memory, uint32_t *reference_bit, uint32_t reps, int bitmap)
+{
+    uint32_t n = memory->n_total_pages, hand = 0;
+    double start = 0.0, reset = 0.0, scan = 0.0;
+
+    //Resetting alone, taken off the total
+    start = now_seconds();
+    for (uint32_t i = 0; i < reps; i++)
+    {
+        if (bitmap)
+        {
+            reset_reference_bits(memory);
+        }
+        else
+        {
+            reset_reference_array(reference_bit, n);
+        }
+    }
+    reset = now_seconds() - start;
+
+    start = now_seconds();
+    for (uint32_t i = 0; i < reps; i++)
+    {
+        if (bitmap)
+        {
+            reset_reference_bits(memory);
+            memory->clock_hand = 0;
+            find_second_chance(memory);
+        }
+        else
+        {
+            reset_reference_array(reference_bit, n);
+            hand = 0;
+            scalar_second_chance(memory->main_memory, reference_bit, n, LOADER_PID, &hand);
+        }
+    }
+    scan = now_seconds() - start;
+
+    return scan > reset ? scan - reset : 0.0;
+}
@@ -0,0 +1,186 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <time.h>
+#include <unistd.h>
+#include "../include/parser.h"
+
+//Constants
+#define DEFAULT_LINES 100000000
+#define DEFAULT_TRACE "bench_trace.txt"
+#define N_REPEATS 3
+
+//Functions
+void generate_trace(char *path, uint64_t n_lines);
+double now_seconds(void);
+double time_fscanf(char *path, uint64_t *n, uint64_t *checksum);
+double time_scanner(char *path, uint64_t *n, uint64_t *checksum);
+
+/*
+Parse throughput benchmark, times the old fscanf loop against the mmap scanner over
+the same generated text trace
+!! USAGE: bench_parser [lines] [trace file], THE TRACE IS ONLY GENERATED IF MISSING
+*/
+int main(int argc, char **argv)
+{
+    uint64_t n_lines = argc > 1 ? strtoull(argv[1], NULL, 10) : DEFAULT_LINES;
+    char *path = argc > 2 ? argv[2] : DEFAULT_TRACE;
+    uint64_t n_fscanf = 0, n_scanner = 0, sum_fscanf = 0, sum_scanner = 0;
+    double t_fscanf = 0.0, t_scanner = 0.0;
+    FILE *fptr = NULL;
+    long size = 0;
+
+    if (access(path, R_OK) != 0)
+    {
+        generate_trace(path, n_lines);
+    }
+    if ((fptr = fopen(path, "r")) == NULL)
+    {
+        fprintf(stderr, "Unable to open file!\n");
+        exit(1);
+    }
+    fseek(fptr, 0, SEEK_END);
+    size = ftell(fptr);
+    fclose(fptr);
+
+    //Best of a few passes each, every pass after the first reads from the page cache
+    for (int i = 0; i < N_REPEATS; i++)
+    {
+        double t = time_scanner(path, &n_scanner, &sum_scanner);
+
+        t_scanner = (i == 0 || t < t_scanner) ? t : t_scanner;
+        t = time_fscanf(path, &n_fscanf, &sum_fscanf);
+        t_fscanf = (i == 0 || t < t_fscanf) ? t : t_fscanf;
+    }
+
+    if (n_fscanf != n_scanner || sum_fscanf != sum_scanner)
+    {
+        fprintf(stderr, "Parsers disagree!\n");
+        exit(1);
+    }
+
+    printf("lines %"PRIu64", %.1f MB\n", n_scanner, size / 1e6);
+    printf("fscanf  %8.3f s %8.1f MB/s %6.1f ns/line\n", t_fscanf, size / 1e6 / t_fscanf, t_fscanf * 1e9 / n_fscanf);
+    printf("scanner %8.3f s %8.1f MB/s %6.1f ns/line\n", t_scanner, size / 1e6 / t_scanner,
+     t_scanner * 1e9 / n_scanner);
+    printf("speedup %.1fx\n", t_fscanf / t_scanner);
+
+    return 0;
+}
+
+/*
+Writes a text trace of random processes, arrivals in order, a few per arrival time
+@params
+path, char *, the trace file to write
+n_lines, uint64_t, number of processes
+*/
+void generate_trace(char *path, uint64_t n_lines)
+{
+    FILE *fptr = fopen(path, "w");
+    uint64_t seed = 88172645463325252ULL;
+    uint32_t time = 0;
+
+    if (!fptr)
+    {
+        fprintf(stderr, "Unable to open file!\n");
+        exit(1);
+    }
+
+    for (uint64_t i = 0; i < n_lines; i++)
+    {
+        //xorshift64, the same trace on every run
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+
+        time += (seed & 3) == 0;
+        fprintf(fptr, "%"PRIu32" %"PRIu64" %"PRIu64" %"PRIu64"\n", time, i + 1,
+         4 * (1 + (seed >> 8) % 256), 1 + (seed >> 24) % 1000);
+    }
+
+    fclose(fptr);
+}
+
+/*
+Reads a monotonic clock
+@return
+double, the time in Seconds
+*/
+double now_seconds(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/*
+Parses a trace with the fscanf loop get_all_processes() used before the scanner
+@params
+path, char *, the trace file
+n, uint64_t *, set to the number of lines parsed
+checksum, uint64_t *, set to a sum over every parsed value
+
+@return
+double, the time taken in Seconds
+*/
+double time_fscanf(char *path, uint64_t *n, uint64_t *checksum)
+{
+    FILE *fptr = fopen(path, "r");
+    uint32_t time = 0, pid = 0, mem = 0, time_fin = 0;
+    double start = now_seconds();
+
+    if (!fptr)
+    {
+        fprintf(stderr, "Unable to open file!\n");
+        exit(1);
+    }
+
+    *n = 0;
+    *checksum = 0;
+    while (fscanf(fptr, "%"SCNd32" %"SCNd32" %"SCNd32" %"SCNd32" ", &time, &pid, &mem, &time_fin) == 4)
+    {
+        *n += 1;
+        *checksum += time + pid + mem + time_fin;
+    }
+    fclose(fptr);
+
+    return now_seconds() - start;
+}
+
+/*
+Parses a trace with the mmap scanner
+@params
+path, char *, the trace file
+n, uint64_t *, set to the number of lines parsed
+checksum, uint64_t *, set to a sum over every parsed value
+
+@return
+double, the time taken in Seconds
+*/
+double time_scanner(char *path, uint64_t *n, uint64_t *checksum)
+{
+    FILE *fptr = fopen(path, "r");
+    struct parser_t *parser = NULL;
+    uint32_t time = 0, pid = 0, mem = 0, time_fin = 0;
+    double start = now_seconds();
+
+    if (!fptr)
+    {
+        fprintf(stderr, "Unable to open file!\n");
+        exit(1);
+    }
+
+    *n = 0;
+    *checksum = 0;
+    parser = open_parser(fptr);
+    while (parse_process_line(parser, &time, &pid, &mem, &time_fin))
+    {
+        *n += 1;
+        *checksum += time + pid + mem + time_fin;
+    }
+    close_parser(parser);
+
+    return now_seconds() - start;
+}
@@ -0,0 +1,160 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include "../include/process_scheduling.h"
+#include "../include/simulation.h"
+#include "../include/memory.h"
+
+//Constants
+#define DEFAULT_PROCESSES 100000
+#define PROCESS_MEMORY 4
+#define PROCESS_JOB_TIME 10
+#define STRESS_QUANTUM 2
+#define SAMPLE_TICKS 1000
+#define N_POLICIES 4
+
+//Functions
+struct arrivals_t *make_arrivals(uint32_t n);
+double now_seconds(void);
+void run_stress(struct arrivals_t *arrivals, char *mem_alloc, uint32_t mem_size);
+
+/*
+Resident bookkeeping stress benchmark, every process arrives at once needing a single page
+and Round-Robin runs each in turn, so every process is loaded together when memory holds
+them all. Each memory policy runs once with room for every process and once with room for
+half, which evicts on every load
+!! THE QUANTUM IS 2, WITH 1 THE PAGE FAULT PENALTY OF v AND ck UNDER EVICTION CANCELS THE
+!! PROGRESS OF EVERY QUANTUM AND THE HALF MEMORY RUNS NEVER FINISH
+!! USAGE: bench_resident [processes]
+!! EACH RUN IS A CHILD PROCESS, SO ITS PEAK RSS IS ITS OWN
+*/
+int main(int argc, char **argv)
+{
+    uint32_t n = argc > 1 ? strtoul(argv[1], NULL, 10) : DEFAULT_PROCESSES;
+    char *policies[N_POLICIES] = {MEM_SWAPPING_X, MEM_VIRTUAL_MEM, MEM_CUSTOM, MEM_CLOCK};
+    struct arrivals_t *arrivals = make_arrivals(n);
+
+    printf("%6s %12s %12s %10s %12s %10s\n", "policy", "memory KB", "max loaded", "seconds", "tick ns",
+     "peak MB");
+    fflush(stdout);
+
+    for (int i = 0; i < N_POLICIES; i++)
+    {
+        for (uint32_t fraction = 1; fraction <= 2; fraction++)
+        {
+            pid_t child = fork();
+
+            if (child < 0)
+            {
+                fprintf(stderr, "Fork failed!\n");
+                exit(1);
+            }
+            if (child == 0)
+            {
+                run_stress(arrivals, policies[i], n * PROCESS_MEMORY / fraction);
+                exit(0);
+            }
+            waitpid(child, NULL, 0);
+        }
+    }
+
+    free_arrivals(arrivals);
+    return 0;
+}
+
+/*
+Generates processes that all arrive at time 0, each needing one page
+@params
+n, uint32_t, number of processes
+
+@return
+struct arrivals_t *, the workload, in ascending pid order
+*/
+struct arrivals_t *make_arrivals(uint32_t n)
+{
+    struct arrivals_t *arrivals = malloc(sizeof(struct arrivals_t));
+
+    if (!arrivals)
+    {
+        fprintf(stderr, "Malloc failed!\n");
+        exit(1);
+    }
+
+    arrivals->n_processes = n;
+    arrivals->capacity = n;
+    for (int c = 0; c < N_TRACE_COLUMNS; c++)
+    {
+        if ((arrivals->columns[c] = malloc(sizeof(uint32_t) * n)) == NULL)
+        {
+            fprintf(stderr, "Malloc failed!\n");
+            exit(1);
+        }
+    }
+
+    for (uint32_t i = 0; i < n; i++)
+    {
+        arrivals->columns[TRACE_ARRIVAL][i] = 0;
+        arrivals->columns[TRACE_PID][i] = i + 1;
+        arrivals->columns[TRACE_MEMORY][i] = PROCESS_MEMORY;
+        arrivals->columns[TRACE_TIME][i] = PROCESS_JOB_TIME;
+    }
+
+    return arrivals;
+}
+
+/*
+Reads a monotonic clock
+@return
+double, the time in Seconds
+*/
+double now_seconds(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/*
+Runs a whole Round-Robin simulation and prints its row, sampling the number of loaded
+processes every SAMPLE_TICKS
+@params
+arrivals, struct arrivals_t *, the workload
+mem_alloc, char *, the memory policy
+mem_size, uint32_t, size of main memory in KB
+*/
+void run_stress(struct arrivals_t *arrivals, char *mem_alloc, uint32_t mem_size)
+{
+    struct sim_config_t config = {.sched_algo = ALGO_ROUNDROBIN, .mem_size = mem_size,
+     .quantum = STRESS_QUANTUM, .transcript = NULL};
+    struct sim_t *sim = NULL;
+    struct rusage usage;
+    uint32_t until = 0, max_loaded = 0;
+    double start = 0.0, elapsed = 0.0;
+
+    strcpy(config.mem_alloc, mem_alloc);
+    sim = sim_create(&config, open_shared_workload(arrivals));
+
+    start = now_seconds();
+    while (!sim_step_until(sim, until += SAMPLE_TICKS))
+    {
+        if (sim->memory->resident->n_sets > max_loaded)
+        {
+            max_loaded = sim->memory->resident->n_sets;
+        }
+    }
+    elapsed = now_seconds() - start;
+
+    getrusage(RUSAGE_SELF, &usage);
+    printf("%6s %12"PRIu32" %12"PRIu32" %10.3f %12.1f %10.1f\n", mem_alloc, mem_size, max_loaded, elapsed,
+     elapsed * 1e9 / sim->cpu_clock, usage.ru_maxrss / 1024.0);
+    fflush(stdout);
+
+    sim_destroy(sim);
+}
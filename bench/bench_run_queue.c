@@ -0,0 +1,301 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <time.h>
+#include "../include/process_scheduling.h"
+#include "../include/simulation.h"
+#include "../include/memory.h"
+
+//Constants
+#define DEFAULT_MAX_LENGTH 1000000
+#define MIN_LENGTH 100
+#define MAX_SHUFFLED_LENGTH 10000
+#define N_ROTATIONS 1000000
+#define N_SIM_QUANTA 200000
+#define LONG_JOB_TIME 1000000000
+#define TRACE_JOB_TIME 10
+
+//Order in which the pids of an arrival batch are pushed
+#define PIDS_ASCENDING 0
+#define PIDS_DESCENDING 1
+#define PIDS_SHUFFLED 2
+
+//Functions
+struct arrivals_t *make_arrivals(uint32_t n, uint32_t same_arrival, int pid_order, uint32_t job_time);
+void write_trace(char *path, struct arrivals_t *arrivals);
+double now_seconds(void);
+double time_pushes(uint32_t n, uint32_t same_arrival, int pid_order, struct run_queue_t *queue,
+ struct workload_t **workload, struct arrivals_t **arrivals);
+double time_rotations(uint32_t n);
+double time_sim_quanta(uint32_t n);
+
+/*
+Run queue benchmark, per-operation cost of Round-Robin as the run queue grows. Every cost
+should stay flat with length, other than pushing a shuffled arrival batch: the batch is kept
+in pid order, so each push walks the batch from batch_prev, and is only run up to
+MAX_SHUFFLED_LENGTH
+!! USAGE: bench_run_queue [max queue length] [trace file]
+!! A TRACE FILE GETS THE LARGEST LENGTH ARRIVING AT ONCE, EACH JOB TRACE_JOB_TIME LONG, FOR
+!! TIMING ./scheduler -a rr -m u -q 1 OVER TRACE_JOB_TIME QUANTA PER PROCESS
+*/
+int main(int argc, char **argv)
+{
+    uint32_t max_length = argc > 1 ? strtoul(argv[1], NULL, 10) : DEFAULT_MAX_LENGTH;
+    struct run_queue_t queue;
+    struct workload_t *workload = NULL;
+    struct arrivals_t *arrivals = NULL;
+    double t_push[3];
+    char shuffled[32];
+
+    printf("%10s %14s %14s %14s %14s %14s\n", "length", "rotate ns", "quantum ns", "push asc ns",
+     "push desc ns", "push shuf ns");
+
+    for (uint32_t n = MIN_LENGTH; n <= max_length; n *= 10)
+    {
+        for (int order = PIDS_ASCENDING; order <= PIDS_SHUFFLED; order++)
+        {
+            if (order == PIDS_SHUFFLED && n > MAX_SHUFFLED_LENGTH)
+            {
+                break;
+            }
+            init_run_queue(&queue, 0);
+            t_push[order] = time_pushes(n, 1, order, &queue, &workload, &arrivals) / n;
+            free_run_queue(&queue);
+            close_workload(workload);
+            free_arrivals(arrivals);
+        }
+
+        if (n > MAX_SHUFFLED_LENGTH)
+        {
+            snprintf(shuffled, sizeof(shuffled), "-");
+        }
+        else
+        {
+            snprintf(shuffled, sizeof(shuffled), "%.1f", t_push[PIDS_SHUFFLED] * 1e9);
+        }
+        printf("%10"PRIu32" %14.1f %14.1f %14.1f %14.1f %14s\n", n, time_rotations(n) * 1e9 / N_ROTATIONS,
+         time_sim_quanta(n) * 1e9 / N_SIM_QUANTA, t_push[PIDS_ASCENDING] * 1e9,
+         t_push[PIDS_DESCENDING] * 1e9, shuffled);
+        fflush(stdout);
+
+        if (n > max_length / 10)
+        {
+            break;
+        }
+    }
+
+    if (argc > 2)
+    {
+        arrivals = make_arrivals(max_length, 1, PIDS_ASCENDING, TRACE_JOB_TIME);
+        write_trace(argv[2], arrivals);
+        free_arrivals(arrivals);
+    }
+
+    return 0;
+}
+
+/*
+Generates a workload of processes that all need no memory
+@params
+n, uint32_t, number of processes
+same_arrival, uint32_t, 1 if every process arrives at time 0, else one arrives per Second
+pid_order, int, PIDS_ASCENDING, PIDS_DESCENDING or PIDS_SHUFFLED
+job_time, uint32_t, time required by every process in Seconds
+
+@return
+struct arrivals_t *, the workload, in order of arrival
+*/
+struct arrivals_t *make_arrivals(uint32_t n, uint32_t same_arrival, int pid_order, uint32_t job_time)
+{
+    struct arrivals_t *arrivals = malloc(sizeof(struct arrivals_t));
+    uint64_t seed = 88172645463325252ULL;
+
+    if (!arrivals)
+    {
+        fprintf(stderr, "Malloc failed!\n");
+        exit(1);
+    }
+
+    arrivals->n_processes = n;
+    arrivals->capacity = n;
+    for (int c = 0; c < N_TRACE_COLUMNS; c++)
+    {
+        if ((arrivals->columns[c] = malloc(sizeof(uint32_t) * n)) == NULL)
+        {
+            fprintf(stderr, "Malloc failed!\n");
+            exit(1);
+        }
+    }
+
+    for (uint32_t i = 0; i < n; i++)
+    {
+        arrivals->columns[TRACE_ARRIVAL][i] = same_arrival ? 0 : i;
+        arrivals->columns[TRACE_PID][i] = pid_order == PIDS_DESCENDING ? n - i : i + 1;
+        arrivals->columns[TRACE_MEMORY][i] = 0;
+        arrivals->columns[TRACE_TIME][i] = job_time;
+    }
+
+    //Fisher-Yates, with xorshift64 so every run pushes the same order
+    if (pid_order == PIDS_SHUFFLED)
+    {
+        for (uint32_t i = n - 1; i > 0; i--)
+        {
+            uint32_t j = 0, tmp = 0;
+
+            seed ^= seed << 13;
+            seed ^= seed >> 7;
+            seed ^= seed << 17;
+            j = seed % (i + 1);
+            tmp = arrivals->columns[TRACE_PID][i];
+            arrivals->columns[TRACE_PID][i] = arrivals->columns[TRACE_PID][j];
+            arrivals->columns[TRACE_PID][j] = tmp;
+        }
+    }
+
+    return arrivals;
+}
+
+/*
+Writes a workload as a text trace
+@params
+path, char *, the trace file to write
+arrivals, struct arrivals_t *, the workload
+*/
+void write_trace(char *path, struct arrivals_t *arrivals)
+{
+    FILE *fptr = fopen(path, "w");
+
+    if (!fptr)
+    {
+        fprintf(stderr, "Unable to open file!\n");
+        exit(1);
+    }
+
+    for (uint64_t i = 0; i < arrivals->n_processes; i++)
+    {
+        fprintf(fptr, "%"PRIu32" %"PRIu32" %"PRIu32" %"PRIu32"\n", arrivals->columns[TRACE_ARRIVAL][i],
+         arrivals->columns[TRACE_PID][i], arrivals->columns[TRACE_MEMORY][i], arrivals->columns[TRACE_TIME][i]);
+    }
+
+    fclose(fptr);
+}
+
+/*
+Reads a monotonic clock
+@return
+double, the time in Seconds
+*/
+double now_seconds(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/*
+Pushes a workload into an empty run queue, as the simulation does on arrival
+@params
+n, uint32_t, number of processes
+same_arrival, uint32_t, 1 if every process arrives at time 0, else one arrives per Second
+pid_order, int, order of the pids of the arrival batch
+queue, struct run_queue_t *, the empty run queue
+workload, struct workload_t **, stores the workload the processes were read from
+arrivals, struct arrivals_t **, stores the generated arrivals
+
+@return
+double, the time taken by every push in Seconds, reading processes excluded
+*/
+double time_pushes(uint32_t n, uint32_t same_arrival, int pid_order, struct run_queue_t *queue,
+ struct workload_t **workload, struct arrivals_t **arrivals)
+{
+    struct process_t **processes = malloc(sizeof(struct process_t *) * n);
+    double start = 0.0, elapsed = 0.0;
+
+    if (!processes)
+    {
+        fprintf(stderr, "Malloc failed!\n");
+        exit(1);
+    }
+
+    *arrivals = make_arrivals(n, same_arrival, pid_order, LONG_JOB_TIME);
+    *workload = open_shared_workload(*arrivals);
+    for (uint32_t i = 0; i < n; i++)
+    {
+        processes[i] = read_process(*workload);
+    }
+
+    start = now_seconds();
+    for (uint32_t i = 0; i < n; i++)
+    {
+        queue_push(queue, processes[i]);
+    }
+    elapsed = now_seconds() - start;
+
+    free(processes);
+    return elapsed;
+}
+
+/*
+Times round_robin_shuffle() on a run queue of a given length
+@params
+n, uint32_t, length of the run queue
+
+@return
+double, the time taken by N_ROTATIONS rotations in Seconds
+*/
+double time_rotations(uint32_t n)
+{
+    struct run_queue_t queue;
+    struct workload_t *workload = NULL;
+    struct arrivals_t *arrivals = NULL;
+    struct memory_t *memory = init_memory(0);
+    double start = 0.0, elapsed = 0.0;
+
+    init_run_queue(&queue, 0);
+    time_pushes(n, 0, PIDS_ASCENDING, &queue, &workload, &arrivals);
+
+    start = now_seconds();
+    for (uint32_t i = 0; i < N_ROTATIONS; i++)
+    {
+        round_robin_shuffle(&queue, &memory);
+    }
+    elapsed = now_seconds() - start;
+
+    free_run_queue(&queue);
+    close_workload(workload);
+    free_arrivals(arrivals);
+    free_memory(memory);
+
+    return elapsed;
+}
+
+/*
+Times a whole Round-Robin simulation with a quantum of 1, once every process has arrived
+@params
+n, uint32_t, number of processes, all arriving at time 0 in ascending pid order
+
+@return
+double, the time taken by N_SIM_QUANTA quanta in Seconds
+*/
+double time_sim_quanta(uint32_t n)
+{
+    struct sim_config_t config = {.sched_algo = ALGO_ROUNDROBIN, .mem_alloc = MEM_UNLIMITED, .mem_size = 0,
+     .quantum = 1, .transcript = NULL};
+    struct arrivals_t *arrivals = make_arrivals(n, 1, PIDS_ASCENDING, LONG_JOB_TIME);
+    struct sim_t *sim = sim_create(&config, open_shared_workload(arrivals));
+    double start = 0.0, elapsed = 0.0;
+
+    //Every process arrives at the first tick
+    sim_step_until(sim, 1);
+
+    start = now_seconds();
+    sim_step_until(sim, 1 + N_SIM_QUANTA);
+    elapsed = now_seconds() - start;
+
+    sim_destroy(sim);
+    free_arrivals(arrivals);
+
+    return elapsed;
+}
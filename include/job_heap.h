@@ -0,0 +1,38 @@
+#ifndef JOB_HEAP_H
+#define JOB_HEAP_H
+
+#include <stdint.h>
+
+struct process_t;
+
+//Heap entry, keeps its (job_time, arrival_time) key, pid and pool slot next to the
+//process so sifting never touches the processes themselves
+typedef struct job_heap_entry_t
+{
+    uint64_t key;
+    uint32_t pid;
+    uint32_t slot;
+    struct process_t *process;
+
+} job_heap_entry_t;
+
+//Binary min-heap of processes keyed on (job_time, arrival_time, pid). positions maps
+//the dense pool slot of every process in the heap to its entry, so a process can be
+//removed from anywhere
+typedef struct job_heap_t
+{
+    struct job_heap_entry_t *entries;
+    uint32_t size;
+    uint32_t capacity;
+    uint32_t *positions;
+    uint32_t n_positions;
+
+} job_heap_t;
+
+struct job_heap_t *init_job_heap();
+void job_heap_insert(struct job_heap_t *, struct process_t *);
+void job_heap_remove(struct job_heap_t *, struct process_t *);
+struct process_t *job_heap_peek(struct job_heap_t *);
+void free_job_heap(struct job_heap_t *);
+
+#endif
@@ -1,26 +1,46 @@
 #ifndef MEMORY_H
 #define MEMORY_H
 
+#include <stdio.h>
 #include <stdint.h>
 #include <inttypes.h>
+#include "../include/writer.h"
+#include "../include/resident_set.h"
+
+#define SIZE_PER_MEM_PAGE 4
 
 typedef struct memory_t
 {
-    uint32_t n_total_proc;
     uint32_t n_total_pages;
-    uint32_t *pid_loaded;
     uint32_t *main_memory;
-    uint32_t *reference_bit;
-    int mem_usage;
+    uint64_t *reference_bits;
+    uint64_t *owned_frames;
+    uint64_t *free_frames;
+    uint32_t n_free_pages;
+    uint32_t free_lo;
+    struct resident_table_t *resident;
+    uint32_t *loaded_addr;
+    uint32_t n_loaded_addr;
+    uint64_t *evicted_frames;
+    uint32_t *evicted_addr;
+    uint32_t n_evicted;
+    uint32_t evicted_lo;
+    uint32_t evicted_hi;
+    uint64_t total_evicted;
+    uint32_t clock_hand;
+    struct writer_t *transcript;
     
 } memory_t;
 
-struct memory_t *init_memory(uint32_t, uint32_t);
-uint32_t load_into_memory_p(struct memory_t **, uint32_t, uint32_t, uint32_t *, uint32_t);
-uint32_t load_into_memory_v(struct memory_t **, uint32_t, uint32_t, uint32_t *, uint32_t *, uint32_t);
-uint32_t load_into_memory_cm(struct memory_t **, uint32_t, uint32_t, uint32_t *, uint32_t *, uint32_t);
+struct memory_t *init_memory(uint32_t);
+uint32_t load_into_memory_p(struct memory_t **, uint32_t, uint32_t, uint32_t);
+uint32_t load_into_memory_v(struct memory_t **, uint32_t, uint32_t, uint32_t *, uint32_t);
+uint32_t load_into_memory_cm(struct memory_t **, uint32_t, uint32_t, uint32_t *, uint32_t, int);
+void rotate_loaded(struct memory_t **);
 void set_reference_bits(struct memory_t **, uint32_t, uint32_t);
-uint32_t *evict_from_memory(struct memory_t **, uint32_t);
+uint32_t evict_from_memory(struct memory_t **, uint32_t);
+uint32_t *collect_evicted(struct memory_t *);
+int memory_usage(struct memory_t *);
 void free_memory(struct memory_t *);
 
 #endif
\ No newline at end of file
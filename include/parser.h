@@ -0,0 +1,36 @@
+#ifndef PARSER_H
+#define PARSER_H
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "../include/trace.h"
+#include "../include/writer.h"
+
+typedef struct parser_t
+{
+    FILE *file;
+    char *data;
+    size_t size;
+    //Window of the input for files that cannot be mapped, refilled as it is parsed
+    size_t capacity;
+    size_t window_offset;
+    int eof;
+    size_t pos;
+    size_t released;
+    size_t line_start;
+    uint32_t line;
+    int mapped;
+    const struct trace_header_t *trace;
+    //Closed before malformed input exits, so the transcript so far is not lost
+    struct writer_t *transcript;
+
+} parser_t;
+
+struct parser_t *open_parser(FILE *);
+int parse_process_line(struct parser_t *, uint32_t *, uint32_t *, uint32_t *, uint32_t *);
+void read_whole_file(struct parser_t *);
+void rewind_parser(struct parser_t *);
+void close_parser(struct parser_t *);
+
+#endif
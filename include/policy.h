@@ -0,0 +1,53 @@
+#ifndef POLICY_H
+#define POLICY_H
+
+#include <stdint.h>
+#include "../include/process_scheduling.h"
+#include "../include/memory.h"
+
+//Scheduling algorithm, resolved once from -a
+typedef struct sched_policy_t
+{
+    char *name;
+    //1 if the run queue is indexed on shortest job for pick_next
+    int job_heap;
+    //Adds a newly arrived process into the run queue
+    void (*on_arrival)(struct run_queue_t *, struct process_t *);
+    //Chooses the process to run next, placing it at the head of the run queue
+    void (*pick_next)(struct run_queue_t *);
+    //Rotates the run queue once the quantum runs out, NULL if not preemptive
+    void (*on_quantum_expiry)(struct run_queue_t *, struct memory_t **);
+
+} sched_policy_t;
+
+//Memory allocation, resolved once from -m
+typedef struct mem_policy_t
+{
+    char *name;
+    int unlimited;
+    //Loads the pages of a process about to run, setting its loading time penalty
+    void (*load)(struct memory_t **, struct process_t *, uint32_t);
+    //Frees all the pages of a finished process
+    void (*evict)(struct memory_t **, struct process_t *, uint32_t);
+    //Updates bookkeeping of a process that has been given the CPU
+    void (*on_run)(struct memory_t **, struct process_t *);
+
+} mem_policy_t;
+
+extern struct sched_policy_t sched_first_come;
+extern struct sched_policy_t sched_round_robin;
+extern struct sched_policy_t sched_shortest_job;
+extern struct mem_policy_t mem_unlimited;
+extern struct mem_policy_t mem_swapping;
+extern struct mem_policy_t mem_virtual;
+extern struct mem_policy_t mem_second_chance;
+extern struct mem_policy_t mem_clock;
+
+struct sched_policy_t *find_sched_policy(char *);
+struct mem_policy_t *find_mem_policy(char *);
+void keep_run_order(struct run_queue_t *);
+void no_memory_update(struct memory_t **, struct process_t *);
+void evict_all_pages(struct memory_t **, struct process_t *, uint32_t);
+void keep_loaded_addresses(struct memory_t *, struct process_t *);
+
+#endif
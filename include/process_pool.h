@@ -0,0 +1,34 @@
+#ifndef PROCESS_POOL_H
+#define PROCESS_POOL_H
+
+#include <stdint.h>
+
+struct process_t;
+
+//Slab of processes, handed out in order and then recycled through the free list. Every
+//process has a dense slot number across all slabs, kept when it is recycled
+typedef struct pool_slab_t
+{
+    struct pool_slab_t *next;
+    uint32_t first_slot;
+    uint32_t n_used;
+    uint32_t size;
+    struct process_t *processes;
+
+} pool_slab_t;
+
+typedef struct process_pool_t
+{
+    struct pool_slab_t *slabs;
+    struct process_t *free_list;
+    uint32_t next_slab_size;
+    uint32_t n_slots;
+
+} process_pool_t;
+
+struct process_pool_t *init_process_pool(uint64_t);
+struct process_t *pool_alloc(struct process_pool_t *);
+void pool_release(struct process_pool_t *, struct process_t *);
+void free_process_pool(struct process_pool_t *);
+
+#endif
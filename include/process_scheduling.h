@@ -1,8 +1,12 @@
 #ifndef PROCESS_SCHEDULING_H
 #define PROCESS_SCHEDULING_H
 
+#include <stdio.h>
 #include <stdint.h>
 #include "../include/memory.h"
+#include "../include/parser.h"
+#include "../include/job_heap.h"
+#include "../include/process_pool.h"
 
 typedef struct process_t
 {
@@ -15,20 +19,68 @@ typedef struct process_t
     uint32_t time_finished;
     uint32_t time_load_penalty;
 
+    uint32_t slot;
+
     uint32_t *memory_address;
+    uint32_t n_memory_address;
+    //Capacity of memory_address, the buffer stays with the slot when the pool recycles it
+    uint32_t memory_address_size;
     struct process_t *next;
+    struct process_t *prev;
 
 } process_t;
 
-struct process_t *get_all_processes(FILE *);
+//Run queue, an intrusive doubly linked list of process_t with O(1) access to both ends.
+//batch_prev is the node after which the processes of the latest arrival batch start,
+//NULL when no batch is being inserted. heap, if any, indexes every process but the head
+//on shortest job
+typedef struct run_queue_t
+{
+    struct process_t *head;
+    struct process_t *tail;
+    struct process_t *batch_prev;
+    uint32_t length;
+    struct job_heap_t *heap;
+
+} run_queue_t;
+
+//Arrivals of a whole input file, one array per column as in a binary trace. Never written
+//once read, so one copy is shared by every simulation of a sweep
+typedef struct arrivals_t
+{
+    uint64_t n_processes;
+    uint64_t capacity;
+    uint32_t *columns[N_TRACE_COLUMNS];
+
+} arrivals_t;
+
+//Processes of a simulation, read lazily from the input file or from shared arrivals. Only
+//the processes read and not yet released are held in the pool
+typedef struct workload_t
+{
+    struct parser_t *parser;
+    const struct arrivals_t *arrivals;
+    uint64_t next_arrival;
+    struct process_pool_t *pool;
+
+} workload_t;
+
+struct arrivals_t *read_all_arrivals(FILE *);
+void free_arrivals(struct arrivals_t *);
+struct workload_t *open_workload(FILE *);
+struct workload_t *open_shared_workload(const struct arrivals_t *);
+struct process_t *read_process(struct workload_t *);
+void release_process(struct workload_t *, struct process_t *);
+void close_workload(struct workload_t *);
 int has_process_arrived(uint32_t, struct process_t *);
-struct process_t *list_push(struct process_t *, struct process_t *);
+void init_run_queue(struct run_queue_t *, int);
+void free_run_queue(struct run_queue_t *);
+void queue_push(struct run_queue_t *, struct process_t *);
+struct process_t *queue_pop(struct run_queue_t *);
 struct process_t *list_pop(struct process_t **);
-struct process_t *list_remove(struct process_t *, struct process_t *);
-uint32_t count_processes(struct process_t *);
 int execute_process(uint32_t, struct process_t **);
-struct process_t *round_robin_shuffle(struct process_t *, struct memory_t **);
-struct process_t *sort_shortest_job(struct process_t *);
-void free_list(struct process_t *);
+uint32_t execute_process_ticks(uint32_t, uint32_t, struct process_t **);
+void round_robin_shuffle(struct run_queue_t *, struct memory_t **);
+void sort_shortest_job(struct run_queue_t *);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,42 @@
+#ifndef RESIDENT_SET_H
+#define RESIDENT_SET_H
+
+#include <stdint.h>
+
+//Page frames held in main memory by one process, in no particular order. lru_prev and
+//lru_next are the pids either side of it in the loaded order
+typedef struct resident_set_t
+{
+    uint32_t pid;
+    uint32_t n_frames;
+    uint32_t capacity;
+    uint32_t *frames;
+    uint32_t lru_prev;
+    uint32_t lru_next;
+
+} resident_set_t;
+
+//Open addressing table of resident sets keyed on pid, only processes with at least
+//one frame have a set. frame_index maps every owned frame to its place in its set,
+//so a frame can be dropped from anywhere. Sets are also linked in the order their
+//processes were loaded, from lru_head to lru_tail
+typedef struct resident_table_t
+{
+    struct resident_set_t *sets;
+    uint32_t capacity;
+    uint32_t n_sets;
+    uint32_t *frame_index;
+    uint32_t lru_head;
+    uint32_t lru_tail;
+
+} resident_table_t;
+
+struct resident_table_t *init_resident_table(uint32_t);
+struct resident_set_t *find_resident_set(struct resident_table_t *, uint32_t);
+uint32_t count_resident(struct resident_table_t *, uint32_t);
+void resident_add(struct resident_table_t *, uint32_t, uint32_t);
+void resident_remove(struct resident_table_t *, uint32_t, uint32_t);
+void rotate_resident(struct resident_table_t *);
+void free_resident_table(struct resident_table_t *);
+
+#endif
@@ -0,0 +1,27 @@
+#ifndef RING_H
+#define RING_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define SIZE_CACHE_LINE 64
+
+//Single producer, single consumer ring of 32 bit words, head is only written by the
+//producer and tail only by the consumer, each on its own cache line
+typedef struct ring_t
+{
+    uint32_t *words;
+    uint64_t mask;
+    int closed;
+    uint64_t head __attribute__((aligned(SIZE_CACHE_LINE)));
+    uint64_t tail __attribute__((aligned(SIZE_CACHE_LINE)));
+
+} ring_t;
+
+struct ring_t *init_ring(uint32_t);
+void ring_push(struct ring_t *, const uint32_t *, size_t);
+size_t ring_pop(struct ring_t *, uint32_t *, size_t);
+void close_ring(struct ring_t *);
+void free_ring(struct ring_t *);
+
+#endif
@@ -0,0 +1,57 @@
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include "../include/process_scheduling.h"
+#include "../include/memory.h"
+#include "../include/utilities.h"
+#include "../include/policy.h"
+#include "../include/writer.h"
+
+#define ALGO_ROUNDROBIN "rr"
+#define ALGO_FCOME_FSERVED "ff"
+#define ALGO_CUSTOM "cs"
+#define MEM_SWAPPING_X "p"
+#define MEM_UNLIMITED "u"
+#define MEM_VIRTUAL_MEM "v"
+#define MEM_CUSTOM "cm"
+#define MEM_CLOCK "ck"
+
+#define SIZE_ALGO 3
+#define SIZE_MEMALLOC 4
+
+typedef struct sim_config_t
+{
+    char sched_algo[SIZE_ALGO];
+    char mem_alloc[SIZE_MEMALLOC];
+    uint32_t mem_size;
+    int quantum;
+    struct writer_t *transcript;
+
+} sim_config_t;
+
+typedef struct sim_t
+{
+    struct sim_config_t config;
+    struct sched_policy_t *sched;
+    struct mem_policy_t *mem_policy;
+    int quantum_clock;
+    int fin_flag;
+    int finished;
+    uint32_t cpu_clock;
+    struct run_queue_t run_queue;
+    struct process_t *incoming_processes;
+    struct workload_t *workload;
+    struct memory_t *memory;
+    struct datalog_t *log;
+
+} sim_t;
+
+struct sim_t *sim_create(struct sim_config_t *, struct workload_t *);
+int sim_step_until(struct sim_t *, uint32_t);
+void sim_run(struct sim_t *);
+void sim_get_metrics(struct sim_t *, struct perf_stats_t *);
+void sim_destroy(struct sim_t *);
+
+#endif
@@ -0,0 +1,25 @@
+#ifndef SWEEP_H
+#define SWEEP_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include "../include/process_scheduling.h"
+#include "../include/utilities.h"
+#include "../include/simulation.h"
+
+typedef struct sweep_t
+{
+    uint32_t n_configs;
+    uint32_t next_config;
+    struct sim_config_t *configs;
+    struct perf_stats_t *results;
+    const struct arrivals_t *arrivals;
+
+} sweep_t;
+
+struct sweep_t *init_sweep(char *, char *, char *, char *);
+void run_sweep(struct sweep_t *, const struct arrivals_t *, int);
+void write_sweep_csv(FILE *, struct sweep_t *);
+void free_sweep(struct sweep_t *);
+
+#endif
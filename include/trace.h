@@ -0,0 +1,34 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
+
+//Binary trace format: a fixed 64 byte header followed by one fixed-width uint32_t
+//array per column, each n_processes long, in host byte order
+#define TRACE_MAGIC "SCHT"
+#define TRACE_VERSION 1
+
+#define TRACE_ARRIVAL 0
+#define TRACE_PID 1
+#define TRACE_MEMORY 2
+#define TRACE_TIME 3
+#define N_TRACE_COLUMNS 4
+
+typedef struct trace_header_t
+{
+    char magic[4];
+    uint32_t version;
+    uint64_t n_processes;
+    uint32_t min[N_TRACE_COLUMNS];
+    uint32_t max[N_TRACE_COLUMNS];
+    uint32_t reserved[4];
+
+} trace_header_t;
+
+const struct trace_header_t *open_trace(const char *, size_t);
+const uint32_t *trace_column(const struct trace_header_t *, int);
+void convert_trace(FILE *, FILE *);
+
+#endif
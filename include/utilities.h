@@ -1,25 +1,41 @@
 #ifndef UTILITIES_H
 #define UTILITIES_H
 
+#include <stdio.h>
 #include <stdint.h>
 #include "../include/process_scheduling.h"
+#include "../include/writer.h"
 
 typedef struct datalog_t 
 {
     uint32_t n_proc_fin;
-    struct process_t *finished_process;
+    double sum_turnaround;
+    double sum_overhead;
+    double max_overhead;
+    uint32_t n_intervals;
+    uint32_t *interval_list;
     
 } datalog_t;
 
+typedef struct perf_stats_t
+{
+    uint32_t throughput[3];
+    int turnaround;
+    double overhead[2];
+    uint32_t makespan;
+    uint64_t evictions;
+
+} perf_stats_t;
+
 struct datalog_t *init_datalog();
 void free_datalog(struct datalog_t *);
 uint32_t *create_uint32_array(uint32_t, uint32_t);
-uint32_t *reinit_uint32_array(uint32_t *, uint32_t, uint32_t);
 struct datalog_t *add_fin_process(struct datalog_t *, struct process_t *);
-void print_process_run(uint32_t, char *, uint32_t, int, uint32_t, struct process_t *);
-void print_process_finish(uint32_t, struct process_t *); 
-void print_memory_evict(uint32_t, uint32_t *, uint32_t); 
-void print_performance_stats(uint32_t, struct datalog_t *);
-uint32_t *add_to_array_nodup(uint32_t *, uint32_t *, uint32_t);
+void print_process_run(struct writer_t *, uint32_t, int, uint32_t, int, struct process_t *);
+void print_process_finish(struct writer_t *, uint32_t, struct process_t *, uint32_t); 
+void print_memory_evict(struct writer_t *, uint32_t, uint32_t *, uint32_t); 
+void get_performance_stats(uint32_t, struct datalog_t *, struct perf_stats_t *);
+void print_performance_stats(FILE *, struct perf_stats_t *);
+void print_eviction_stats(FILE *, struct perf_stats_t *);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,58 @@
+#ifndef WRITER_H
+#define WRITER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <pthread.h>
+#include "../include/ring.h"
+
+#define SIZE_WRITER_BUFFER (1 << 20)
+#define RING_CAPACITY_LOG2 20
+
+#define FORMAT_TEXT 0
+#define FORMAT_CSV 1
+#define FORMAT_JSONL 2
+
+#define LOG_RUNNING 0
+#define LOG_EVICTED 1
+#define LOG_FINISHED 2
+
+//Compact transcript record, followed by its n_mem_addr memory addresses when it goes
+//through the ring
+typedef struct log_event_t
+{
+    uint32_t type;
+    uint32_t cpu_clock;
+    uint32_t pid;
+    uint32_t time_required;
+    uint32_t load_time;
+    uint32_t mem_usage;
+    uint32_t proc_remaining;
+    uint32_t flag_unlimited;
+    uint32_t n_mem_addr;
+
+} log_event_t;
+
+typedef struct writer_t
+{
+    int fd;
+    int format;
+    char *buffer;
+    size_t size;
+    struct ring_t *ring;
+    pthread_t thread;
+
+} writer_t;
+
+struct writer_t *open_writer(int, int);
+int find_format(char *);
+void start_writer_thread(struct writer_t *);
+void write_event(struct writer_t *, struct log_event_t *, const uint32_t *);
+void writer_put_str(struct writer_t *, const char *);
+void writer_put_char(struct writer_t *, char);
+void writer_put_uint(struct writer_t *, uint32_t);
+void writer_put_int(struct writer_t *, int32_t);
+void flush_writer(struct writer_t *);
+void close_writer(struct writer_t *);
+
+#endif
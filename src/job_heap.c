@@ -0,0 +1,230 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "../include/job_heap.h"
+#include "../include/process_scheduling.h"
+
+//Constants
+#define INIT_HEAP_CAPACITY 64
+
+//Functions
+int entry_before(struct job_heap_entry_t *, struct job_heap_entry_t *);
+void heap_place(struct job_heap_t *, uint32_t, struct job_heap_entry_t);
+void sift_up(struct job_heap_t *, uint32_t);
+void sift_down(struct job_heap_t *, uint32_t);
+void reserve_position(struct job_heap_t *, uint32_t);
+
+/*
+Creates an empty job heap
+@return
+struct job_heap_t *, the heap
+*/
+struct job_heap_t *init_job_heap()
+{
+    struct job_heap_t *heap = malloc(sizeof(struct job_heap_t));
+
+    if (!heap)
+    {
+        fprintf(stderr, "Malloc failed!\n");
+        exit(1);
+    }
+
+    heap->size = 0;
+    heap->capacity = INIT_HEAP_CAPACITY;
+    heap->entries = malloc(sizeof(struct job_heap_entry_t) * heap->capacity);
+    heap->n_positions = INIT_HEAP_CAPACITY;
+    heap->positions = malloc(sizeof(uint32_t) * heap->n_positions);
+
+    if (!heap->entries || !heap->positions)
+    {
+        fprintf(stderr, "Malloc failed!\n");
+        exit(1);
+    }
+
+    return heap;
+}
+
+/*
+Checks if an entry comes before another, shorter job first then earlier arrival then
+smaller pid
+@params
+a, struct job_heap_entry_t *, an entry
+b, struct job_heap_entry_t *, another entry
+
+@return
+int, 1 if a comes first, 0 otherwise
+*/
+int entry_before(struct job_heap_entry_t *a, struct job_heap_entry_t *b)
+{
+    if (a->key != b->key)
+    {
+        return a->key < b->key;
+    }
+    return a->pid < b->pid;
+}
+
+/*
+Puts an entry into a slot of the heap, keeping its position up to date
+@params
+heap, struct job_heap_t *, the heap
+i, uint32_t, the slot
+entry, struct job_heap_entry_t, the entry
+*/
+void heap_place(struct job_heap_t *heap, uint32_t i, struct job_heap_entry_t entry)
+{
+    heap->entries[i] = entry;
+    heap->positions[entry.slot] = i;
+}
+
+/*
+Moves the entry in a slot up until its parent comes before it
+@params
+heap, struct job_heap_t *, the heap
+i, uint32_t, the slot
+*/
+void sift_up(struct job_heap_t *heap, uint32_t i)
+{
+    struct job_heap_entry_t entry = heap->entries[i];
+
+    while (i > 0 && entry_before(&entry, &heap->entries[(i - 1) / 2]))
+    {
+        heap_place(heap, i, heap->entries[(i - 1) / 2]);
+        i = (i - 1) / 2;
+    }
+    heap_place(heap, i, entry);
+}
+
+/*
+Moves the entry in a slot down until it comes before both its children
+@params
+heap, struct job_heap_t *, the heap
+i, uint32_t, the slot
+*/
+void sift_down(struct job_heap_t *heap, uint32_t i)
+{
+    struct job_heap_entry_t entry = heap->entries[i];
+
+    while (2 * i + 1 < heap->size)
+    {
+        uint32_t child = 2 * i + 1;
+
+        if (child + 1 < heap->size && entry_before(&heap->entries[child + 1], &heap->entries[child]))
+        {
+            child += 1;
+        }
+        if (!entry_before(&heap->entries[child], &entry))
+        {
+            break;
+        }
+        heap_place(heap, i, heap->entries[child]);
+        i = child;
+    }
+    heap_place(heap, i, entry);
+}
+
+/*
+Grows the position map to cover a pool slot
+@params
+heap, struct job_heap_t *, the heap
+slot, uint32_t, the pool slot
+*/
+void reserve_position(struct job_heap_t *heap, uint32_t slot)
+{
+    if (slot < heap->n_positions)
+    {
+        return;
+    }
+
+    while (heap->n_positions <= slot)
+    {
+        heap->n_positions *= 2;
+    }
+    heap->positions = realloc(heap->positions, sizeof(uint32_t) * heap->n_positions);
+
+    if (!heap->positions)
+    {
+        fprintf(stderr, "Malloc failed!\n");
+        exit(1);
+    }
+}
+
+/*
+Inserts a process into the heap in O(log n)
+@params
+heap, struct job_heap_t *, the heap
+process, struct process_t *, the process, taken from a pool and not already in the heap
+*/
+void job_heap_insert(struct job_heap_t *heap, struct process_t *process)
+{
+    struct job_heap_entry_t entry;
+
+    if (heap->size == heap->capacity)
+    {
+        heap->capacity *= 2;
+        heap->entries = realloc(heap->entries, sizeof(struct job_heap_entry_t) * heap->capacity);
+
+        if (!heap->entries)
+        {
+            fprintf(stderr, "Malloc failed!\n");
+            exit(1);
+        }
+    }
+    reserve_position(heap, process->slot);
+
+    entry.key = ((uint64_t)process->job_time << 32) | process->arrival_time;
+    entry.pid = process->pid;
+    entry.slot = process->slot;
+    entry.process = process;
+
+    heap_place(heap, heap->size, entry);
+    heap->size += 1;
+    sift_up(heap, heap->size - 1);
+}
+
+/*
+Removes a process from anywhere in the heap in O(log n)
+@params
+heap, struct job_heap_t *, the heap
+process, struct process_t *, the process, must be in the heap
+*/
+void job_heap_remove(struct job_heap_t *heap, struct process_t *process)
+{
+    uint32_t i = heap->positions[process->slot];
+
+    heap->size -= 1;
+
+    //Last slot fills the hole, then moves whichever way restores the order
+    if (i < heap->size)
+    {
+        uint32_t moved = heap->entries[heap->size].slot;
+
+        heap_place(heap, i, heap->entries[heap->size]);
+        sift_up(heap, i);
+        sift_down(heap, heap->positions[moved]);
+    }
+}
+
+/*
+Gets the process that comes first in the heap
+@params
+heap, struct job_heap_t *, the heap
+
+@return
+struct process_t *, the first process, NULL if the heap is empty
+*/
+struct process_t *job_heap_peek(struct job_heap_t *heap)
+{
+    return heap->size > 0 ? heap->entries[0].process : NULL;
+}
+
+/*
+Frees a job heap, not the processes in it
+@params
+heap, struct job_heap_t *, the heap
+*/
+void free_job_heap(struct job_heap_t *heap)
+{
+    free(heap->entries);
+    free(heap->positions);
+    free(heap);
+}
@@ -0,0 +1,96 @@
+#include <stdlib.h>
+#include <stdint.h>
+#include "../include/policy.h"
+#include "../include/utilities.h"
+
+void load_second_chance(struct memory_t **memory, struct process_t *process, uint32_t cpu_clock);
+void load_clock(struct memory_t **memory, struct process_t *process, uint32_t cpu_clock);
+void load_referenced_pages(struct memory_t **memory, struct process_t *process, uint32_t cpu_clock,
+ int flag_clock);
+void reference_pages(struct memory_t **memory, struct process_t *process);
+
+/*
+Custom memory, Second-Chance page replacement, pages of a running process are referenced
+and skipped once when looking for a page to evict
+*/
+struct mem_policy_t mem_second_chance = {
+    .name = "cm",
+    .unlimited = 0,
+    .load = load_second_chance,
+    .evict = evict_all_pages,
+    .on_run = reference_pages,
+};
+
+/*
+Second-Chance as a true CLOCK, the search for a page to evict carries on from where the
+last one stopped instead of restarting at frame 0
+*/
+struct mem_policy_t mem_clock = {
+    .name = "ck",
+    .unlimited = 0,
+    .load = load_clock,
+    .evict = evict_all_pages,
+    .on_run = reference_pages,
+};
+
+/*
+Loads pages of a process into memory in Second-Chance mode, adding page fault penalties
+to its remaining time
+@params
+memory, struct memory_t **, pointer to the memory_t * to allow modification
+process, struct process_t *, the process about to run
+cpu_clock, uint32_t, representation of CPU clock in Seconds
+*/
+void load_second_chance(struct memory_t **memory, struct process_t *process, uint32_t cpu_clock)
+{
+    load_referenced_pages(memory, process, cpu_clock, 0);
+}
+
+/*
+Loads pages of a process into memory in CLOCK mode, adding page fault penalties to its
+remaining time
+@params
+memory, struct memory_t **, pointer to the memory_t * to allow modification
+process, struct process_t *, the process about to run
+cpu_clock, uint32_t, representation of CPU clock in Seconds
+*/
+void load_clock(struct memory_t **memory, struct process_t *process, uint32_t cpu_clock)
+{
+    load_referenced_pages(memory, process, cpu_clock, 1);
+}
+
+/*
+Loads pages of a process into memory, evicting pages without a second chance, and adds
+page fault penalties to its remaining time
+@params
+memory, struct memory_t **, pointer to the memory_t * to allow modification
+process, struct process_t *, the process about to run
+cpu_clock, uint32_t, representation of CPU clock in Seconds
+flag_clock, int, 1 if the clock hand persists across searches
+*/
+void load_referenced_pages(struct memory_t **memory, struct process_t *process, uint32_t cpu_clock,
+ int flag_clock)
+{
+    uint32_t load_penalty = 0, page_fault_penalty = 0;
+
+    load_penalty = load_into_memory_cm(memory, process->pid, process->memory_required,
+     &page_fault_penalty, cpu_clock, flag_clock);
+    process->time_load_penalty = load_penalty;
+    process->time_required += page_fault_penalty;
+    //Updates memory address if pages were not in memory already before suspension
+    if (load_penalty > 0)
+    {
+        keep_loaded_addresses(*memory, process);
+    }
+}
+
+/*
+Sets the reference bits of every page of a process given the CPU
+@params
+memory, struct memory_t **, pointer to the memory_t * to allow modification
+process, struct process_t *, the running process
+*/
+void reference_pages(struct memory_t **memory, struct process_t *process)
+{
+    set_reference_bits(memory, 1, process->pid);
+}
@@ -0,0 +1,38 @@
+#include <stdlib.h>
+#include <stdint.h>
+#include "../include/policy.h"
+#include "../include/utilities.h"
+
+void load_swapping(struct memory_t **memory, struct process_t *process, uint32_t cpu_clock);
+
+/*
+Swapping-X memory, loads every page of a process, swapping out least-recently-used processes
+as a whole
+*/
+struct mem_policy_t mem_swapping = {
+    .name = "p",
+    .unlimited = 0,
+    .load = load_swapping,
+    .evict = evict_all_pages,
+    .on_run = no_memory_update,
+};
+
+/*
+Loads all pages of a process into memory in Swapping-X mode
+@params
+memory, struct memory_t **, pointer to the memory_t * to allow modification
+process, struct process_t *, the process about to run
+cpu_clock, uint32_t, representation of CPU clock in Seconds
+*/
+void load_swapping(struct memory_t **memory, struct process_t *process, uint32_t cpu_clock)
+{
+    uint32_t load_penalty = 0;
+
+    load_penalty = load_into_memory_p(memory, process->pid, process->memory_required, cpu_clock);
+    process->time_load_penalty = load_penalty;
+    //Updates memory address if pages were not in memory already before suspension
+    if (load_penalty > 0)
+    {
+        keep_loaded_addresses(*memory, process);
+    }
+}
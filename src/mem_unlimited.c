@@ -0,0 +1,44 @@
+#include <stdint.h>
+#include "../include/policy.h"
+
+void load_unlimited(struct memory_t **memory, struct process_t *process, uint32_t cpu_clock);
+void evict_unlimited(struct memory_t **memory, struct process_t *process, uint32_t cpu_clock);
+
+/*
+Unlimited memory, every process is always in memory with no loading time
+*/
+struct mem_policy_t mem_unlimited = {
+    .name = "u",
+    .unlimited = 1,
+    .load = load_unlimited,
+    .evict = evict_unlimited,
+    .on_run = no_memory_update,
+};
+
+/*
+Nothing to load in Unlimited Memory mode
+@params
+memory, struct memory_t **, unused
+process, struct process_t *, unused
+cpu_clock, uint32_t, unused
+*/
+void load_unlimited(struct memory_t **memory, struct process_t *process, uint32_t cpu_clock)
+{
+    (void) memory;
+    (void) process;
+    (void) cpu_clock;
+}
+
+/*
+Nothing to evict in Unlimited Memory mode
+@params
+memory, struct memory_t **, unused
+process, struct process_t *, unused
+cpu_clock, uint32_t, unused
+*/
+void evict_unlimited(struct memory_t **memory, struct process_t *process, uint32_t cpu_clock)
+{
+    (void) memory;
+    (void) process;
+    (void) cpu_clock;
+}
@@ -0,0 +1,41 @@
+#include <stdlib.h>
+#include <stdint.h>
+#include "../include/policy.h"
+#include "../include/utilities.h"
+
+void load_virtual(struct memory_t **memory, struct process_t *process, uint32_t cpu_clock);
+
+/*
+Virtual memory, loads as few as 4 pages of a process, evicting pages of least-recently-used
+processes one by one
+*/
+struct mem_policy_t mem_virtual = {
+    .name = "v",
+    .unlimited = 0,
+    .load = load_virtual,
+    .evict = evict_all_pages,
+    .on_run = no_memory_update,
+};
+
+/*
+Loads pages of a process into memory in Virtual Memory mode, adding page fault penalties
+to its remaining time
+@params
+memory, struct memory_t **, pointer to the memory_t * to allow modification
+process, struct process_t *, the process about to run
+cpu_clock, uint32_t, representation of CPU clock in Seconds
+*/
+void load_virtual(struct memory_t **memory, struct process_t *process, uint32_t cpu_clock)
+{
+    uint32_t load_penalty = 0, page_fault_penalty = 0;
+
+    load_penalty = load_into_memory_v(memory, process->pid, process->memory_required,
+     &page_fault_penalty, cpu_clock);
+    process->time_load_penalty = load_penalty;
+    process->time_required += page_fault_penalty;
+    //Updates memory address if pages were not in memory already before suspension
+    if (load_penalty > 0)
+    {
+        keep_loaded_addresses(*memory, process);
+    }
+}
@@ -6,29 +6,34 @@
 #include "../include/memory.h"
 #include "../include/utilities.h"
 
-#define SIZE_PER_MEM_PAGE 4
 #define LOADTIME_SWAPPING 2
 #define SIZE_VMEM_MIN_RUN 16
+#define BITS_PER_FRAME_WORD 64
 
 uint32_t count_unused_mem(struct memory_t *memory);
-uint32_t *add_into_memory(struct memory_t **memory, uint32_t pid, uint32_t pages, uint32_t *mem_addr);
+void add_into_memory(struct memory_t **memory, uint32_t pid, uint32_t pages);
 uint32_t find_evictee_lru(struct memory_t *memory);
-void update_mem_usage(struct memory_t **memory);
 uint32_t has_been_loaded(struct memory_t *memory, uint32_t pid);
-uint32_t *evict_one_by_one(struct memory_t **memory, uint32_t pid);
+uint32_t evict_one_by_one(struct memory_t **memory, uint32_t pid);
+uint64_t *create_frame_bitmap(uint32_t n_pages, uint64_t fill, uint64_t past_end);
+uint32_t find_second_chance(struct memory_t *memory);
+void mark_owned_frames(struct memory_t *memory, uint32_t pid, uint32_t flag);
+void claim_frame(struct memory_t *memory, uint32_t frame, uint32_t pid);
+void release_frame(struct memory_t *memory, uint32_t frame);
+void mark_evicted(struct memory_t *memory, uint32_t frame);
+void count_load_evictions(struct memory_t *memory, uint32_t n_free);
 
 /*
 Initialises the memory_t struct, representation of main memory
 Init values of memory is UINT32_MAX to prevent conflict with pid 0
+!! LOADED PROCESSES ARE TRACKED IN A TABLE THAT GROWS AS NEEDED
 @params
 mem_size, uint32_t, max size of main memory in KB
-n_total_proc, uint32_t, total number of processes loaded into 
-    memory at any given time
 
 @return
 struct memory_t *, the initialised memory
 */
-struct memory_t *init_memory(uint32_t mem_size, uint32_t n_total_proc)
+struct memory_t *init_memory(uint32_t mem_size)
 {
     struct memory_t *mem = malloc(sizeof(struct memory_t));
 
@@ -38,11 +43,24 @@ struct memory_t *init_memory(uint32_t mem_size, uint32_t n_total_proc)
         exit(1);
     }
     mem->n_total_pages = mem_size / SIZE_PER_MEM_PAGE;
-    mem->n_total_proc = n_total_proc;
-    mem->mem_usage = 0;
-    mem->pid_loaded = create_uint32_array(n_total_proc, UINT32_MAX);
+    mem->transcript = NULL;
     mem->main_memory = create_uint32_array(mem->n_total_pages, UINT32_MAX);
-    mem->reference_bit = create_uint32_array(mem->n_total_pages, 0);
+    mem->reference_bits = create_frame_bitmap(mem->n_total_pages, 0, 0);
+    mem->owned_frames = create_frame_bitmap(mem->n_total_pages, 0, UINT64_MAX);
+    mem->free_frames = create_frame_bitmap(mem->n_total_pages, UINT64_MAX, 0);
+    mem->n_free_pages = mem->n_total_pages;
+    mem->free_lo = 0;
+    mem->resident = init_resident_table(mem->n_total_pages);
+    mem->loaded_addr = create_uint32_array(mem->n_total_pages, UINT32_MAX);
+    mem->n_loaded_addr = 0;
+    mem->evicted_frames = create_frame_bitmap(mem->n_total_pages, 0, 0);
+    //An eviction episode lists each frame at most once
+    mem->evicted_addr = create_uint32_array(mem->n_total_pages + 1, UINT32_MAX);
+    mem->n_evicted = 0;
+    mem->evicted_lo = UINT32_MAX;
+    mem->clock_hand = 0;
+    mem->evicted_hi = 0;
+    mem->total_evicted = 0;
 
     return mem;
 }
@@ -57,11 +75,11 @@ mem_size, uint32_t, size of memory to be allocated in KB
 cpu_clock, uint32_t, representation of CPU clock in Seconds
 
 @return
-uint32_t, the time required to load given process' pages into memory, in Seconds
+uint32_t, the time required to load given process' pages into memory, in Seconds,
+    addresses of the newly loaded pages are kept in loaded_addr
 */
-uint32_t load_into_memory_p(struct memory_t **memory, uint32_t pid, uint32_t mem_size, uint32_t *mem_addr, uint32_t cpu_clock)
+uint32_t load_into_memory_p(struct memory_t **memory, uint32_t pid, uint32_t mem_size, uint32_t cpu_clock)
 {
-    uint32_t *evicted_mem = NULL, *final_evict_addr = NULL;
     uint32_t evictee = 0;
     uint32_t req_pages = mem_size / SIZE_PER_MEM_PAGE;
     uint32_t free_space = count_unused_mem(*memory);
@@ -72,30 +90,29 @@ uint32_t load_into_memory_p(struct memory_t **memory, uint32_t pid, uint32_t mem
         return 0;
     }
     
-    mem_addr = reinit_uint32_array(mem_addr, (*memory)->n_total_pages, UINT32_MAX);
+    (*memory)->n_loaded_addr = 0;
 
     //Loads process pages into memory if available space
     if (free_space >= req_pages)
     {
-        mem_addr = add_into_memory(memory, pid, req_pages, mem_addr);
+        add_into_memory(memory, pid, req_pages);
     }
     //Evict processes by least-recently-used
     else
     {
-        final_evict_addr = create_uint32_array((*memory)->n_total_pages, UINT32_MAX);
         //Keep evicting until available memory space
         while(free_space < req_pages)
         {
             //Find pid of evictee, UINT32_MAX if none found
             evictee = find_evictee_lru(*memory);
 
-            evicted_mem = evict_from_memory(memory, evictee);
-            final_evict_addr = add_to_array_nodup(final_evict_addr, evicted_mem, (*memory)->n_total_pages);
+            evict_from_memory(memory, evictee);
 
             free_space = count_unused_mem(*memory);
         }
-        print_memory_evict(cpu_clock, final_evict_addr, (*memory)->n_total_pages);
-        mem_addr = add_into_memory(memory, pid, req_pages, mem_addr);   
+        count_load_evictions(*memory, 0);
+        print_memory_evict((*memory)->transcript, cpu_clock, collect_evicted(*memory), (*memory)->n_total_pages);
+        add_into_memory(memory, pid, req_pages);
     }
     return req_pages*LOADTIME_SWAPPING;
 }
@@ -111,12 +128,12 @@ page_fault, uint32_t *, pointer to time penalty offset for page faults in Second
 cpu_clock, uint32_t, representation of CPU clock in Seconds
 
 @return
-uint32_t, the time required to load given process' pages into memory, in Seconds
+uint32_t, the time required to load given process' pages into memory, in Seconds,
+    addresses of the newly loaded pages are kept in loaded_addr
 */
 uint32_t load_into_memory_v(struct memory_t **memory, uint32_t pid, uint32_t mem_size,
- uint32_t *mem_addr, uint32_t *fault, uint32_t cpu_clock)
+ uint32_t *fault, uint32_t cpu_clock)
 {
-    uint32_t *final_evict_addr = NULL, *evicted_mem = NULL;
     uint32_t min_exec_pages = SIZE_VMEM_MIN_RUN / SIZE_PER_MEM_PAGE;
     uint32_t evictee = 0, loaded_pages = 0, n_loaded = 0;
     uint32_t req_pages = mem_size / SIZE_PER_MEM_PAGE;
@@ -142,7 +159,7 @@ uint32_t load_into_memory_v(struct memory_t **memory, uint32_t pid, uint32_t mem
         return 0;
     }
 
-    mem_addr = reinit_uint32_array(mem_addr, (*memory)->n_total_pages, UINT32_MAX);
+    (*memory)->n_loaded_addr = 0;
 
     //Loads all process pages into memory if available space
     if (free_space >= (req_pages - loaded_pages))
@@ -160,7 +177,6 @@ uint32_t load_into_memory_v(struct memory_t **memory, uint32_t pid, uint32_t mem
     else
     {
         *fault = 1;
-        final_evict_addr = create_uint32_array((*memory)->n_total_pages, UINT32_MAX);
         //Keep evicting until minimum execution pages met or process has enough to fit all if less
         //memory needed
         while (free_space < min_exec_pages && free_space < (req_pages - loaded_pages))
@@ -174,20 +190,18 @@ uint32_t load_into_memory_v(struct memory_t **memory, uint32_t pid, uint32_t mem
                 cont_flag = 1;
             }
             
-            evicted_mem = evict_one_by_one(memory, evictee);
-
             //Did not evict any memory address means no more pages in memory
-            if (evicted_mem == NULL)
+            if (evict_one_by_one(memory, evictee) == UINT32_MAX)
             {
                 cont_flag = 0;
                 continue;
             }
-            final_evict_addr = add_to_array_nodup(final_evict_addr, evicted_mem, (*memory)->n_total_pages);
 
             free_space = count_unused_mem(*memory);
         }
 
-        print_memory_evict(cpu_clock, final_evict_addr, (*memory)->n_total_pages);
+        count_load_evictions(*memory, 0);
+        print_memory_evict((*memory)->transcript, cpu_clock, collect_evicted(*memory), (*memory)->n_total_pages);
 
         if ((req_pages - loaded_pages) < min_exec_pages)
         {
@@ -198,9 +212,7 @@ uint32_t load_into_memory_v(struct memory_t **memory, uint32_t pid, uint32_t mem
             n_loaded = min_exec_pages;
         }
     }
-    mem_addr = add_into_memory(memory, pid, n_loaded, mem_addr);
-
-    update_mem_usage(memory);
+    add_into_memory(memory, pid, n_loaded);
 
     return n_loaded*LOADTIME_SWAPPING;
 }
@@ -214,19 +226,21 @@ pid, uint32_t, Process ID of requesting process
 mem_size, uint32_t, size of memory to be allocated in KB    
 page_fault, uint32_t *, pointer to time penalty offset for page faults in Seconds
 cpu_clock, uint32_t, representation of CPU clock in Seconds
+flag_clock, int, 1 if the clock hand carries on from the last victim, 0 if every search
+    restarts at frame 0
 
 @return
-uint32_t, the time required to load given process' pages into memory, in Seconds
+uint32_t, the time required to load given process' pages into memory, in Seconds,
+    addresses of the newly loaded pages are kept in loaded_addr
 */
 uint32_t load_into_memory_cm(struct memory_t **memory, uint32_t pid, uint32_t mem_size,
- uint32_t *mem_addr, uint32_t *fault, uint32_t cpu_clock)
+ uint32_t *fault, uint32_t cpu_clock, int flag_clock)
 {
-    uint32_t *final_evict_addr = NULL, *evicted_mem = NULL;
     uint32_t min_exec_pages = SIZE_VMEM_MIN_RUN / SIZE_PER_MEM_PAGE;
-    uint32_t loaded_pages = 0, n_loaded = 0, prev_proc = UINT32_MAX;
+    uint32_t loaded_pages = 0, n_loaded = 0;
     uint32_t req_pages = mem_size / SIZE_PER_MEM_PAGE;
     uint32_t free_space = count_unused_mem(*memory);
-    int found_flag = 0;
+    uint32_t victim = 0, n_free_victims = 0;
     
     loaded_pages = has_been_loaded(*memory, pid);
     *fault = 0;
@@ -247,13 +261,13 @@ uint32_t load_into_memory_cm(struct memory_t **memory, uint32_t pid, uint32_t me
         return 0;
     }
     
-    mem_addr = reinit_uint32_array(mem_addr, (*memory)->n_total_pages, UINT32_MAX);
+    (*memory)->n_loaded_addr = 0;
     
     //Loads all process pages into memory if available space
     if (free_space >= (req_pages - loaded_pages))
     {       
         n_loaded = req_pages - loaded_pages;
-        mem_addr = add_into_memory(memory, pid, n_loaded, mem_addr);
+        add_into_memory(memory, pid, n_loaded);
     }
     //Loads as much pages as possible if free space meets minimum execution pages
     //but not enough free space to load all process pages
@@ -261,71 +275,46 @@ uint32_t load_into_memory_cm(struct memory_t **memory, uint32_t pid, uint32_t me
     {
         *fault = 1;
         n_loaded = free_space;
-        mem_addr = add_into_memory(memory, pid, n_loaded, mem_addr);
+        add_into_memory(memory, pid, n_loaded);
     }
     //Evicts some/all processes until minimum execution requirement
     else
     {
-        final_evict_addr = create_uint32_array((*memory)->n_total_pages, UINT32_MAX);
         *fault = 1;
         
+        //Frames of the executing process are skipped by the second chance search
+        mark_owned_frames(*memory, pid, 1);
+
         //Loop until enough space to insert required pages
         for (uint32_t _n = 0; _n < (req_pages - loaded_pages) && _n < min_exec_pages; _n ++)
         {
-            
-            while(!found_flag)
+            //Replace page with no second chance
+            if (!flag_clock)
+            {
+                (*memory)->clock_hand = 0;
+            }
+            victim = find_second_chance(*memory);
+            //Every frame belongs to the executing process, nothing left to evict
+            if (victim == UINT32_MAX)
             {
-                //Loop through second chance
-                for (uint32_t i = 0; i < (*memory)->n_total_pages; i++)
-                {
-                    //skip page frame if owned by executing process
-                    if ((*memory)->main_memory[i] == pid)
-                    {
-                        continue;
-                    }
-                    //Replace page with no second chance
-                    if ((*memory)->reference_bit[i] == 0)
-                    {
-                        found_flag = 1;
-                        prev_proc = (*memory)->main_memory[i];
-                        (*memory)->main_memory[i] = pid;
-                        evicted_mem = create_uint32_array((*memory)->n_total_pages, UINT32_MAX);
-                        evicted_mem[0] = i;
-                        n_loaded += 1;
-
-                        //Check if evicted process still has any pages in memory
-                        if (has_been_loaded(*memory, prev_proc) <= 0)
-                        {
-                            //Remove pid from book keeping
-                            for (uint32_t j = 0; i < (*memory)->n_total_proc; i++)
-                            {
-                                if ((*memory)->pid_loaded[j] == prev_proc)
-                                {
-                                    (*memory)->pid_loaded[j] = UINT32_MAX;
-                                    break;
-                                }
-                            }
-                        }
-                        final_evict_addr = add_to_array_nodup(final_evict_addr, evicted_mem, (*memory)->n_total_pages);
-
-                        break;
-                    }
-                    //Set reference bit to 0 
-                    else
-                    {
-                        (*memory)->reference_bit[i] = 0;
-                    }
-                    
-                }
+                break;
             }
-            found_flag = 0;
+            //Free frames are listed as evicted, as they always were, but not counted
+            if ((*memory)->main_memory[victim] == UINT32_MAX)
+            {
+                n_free_victims += 1;
+            }
+            mark_evicted(*memory, victim);
+            claim_frame(*memory, victim, pid);
+            (*memory)->owned_frames[victim / BITS_PER_FRAME_WORD] |= UINT64_C(1) << (victim % BITS_PER_FRAME_WORD);
+            n_loaded += 1;
         }   
+        mark_owned_frames(*memory, pid, 0);
         *fault = 1;
 
-        print_memory_evict(cpu_clock, final_evict_addr, (*memory)->n_total_pages);
+        count_load_evictions(*memory, n_free_victims);
+        print_memory_evict((*memory)->transcript, cpu_clock, collect_evicted(*memory), (*memory)->n_total_pages);
     }
-    
-    update_mem_usage(memory);
 
     return n_loaded*LOADTIME_SWAPPING;
 }
@@ -338,41 +327,31 @@ memory, struct memory_t **, pointer to the memory_t * to allow modification
 pid, uint32_t, process id of evictee :(
 
 @return
-uint32_t *, memory space address freed, due to eviction
+uint32_t, memory space address freed and marked evicted, UINT32_MAX if none
 */
-uint32_t *evict_one_by_one(struct memory_t **memory, uint32_t pid)
+uint32_t evict_one_by_one(struct memory_t **memory, uint32_t pid)
 {
-    uint32_t *ret_pack = NULL;
+    struct resident_set_t *set = find_resident_set((*memory)->resident, pid);
+    uint32_t first = UINT32_MAX;
 
-    //Start evicting process' pages from memory
-    for (uint32_t i = 0; i < (*memory)->n_total_pages; i++)
+    if (!set)
     {
-        if ((*memory)->main_memory[i] == pid)
-        {
-            //Creates an array, with first element as address and rest as
-            //padding 
-            ret_pack = create_uint32_array((*memory)->n_total_pages, UINT32_MAX);
-            (*memory)->main_memory[i] = UINT32_MAX;
-            ret_pack[0] = i;
+        return UINT32_MAX;
+    }
 
-            if (has_been_loaded(*memory, pid) <= 0)
-            {
-                //Remove pid from book keeping
-                for (uint32_t i = 0; i < (*memory)->n_total_proc; i++)
-                {
-                    if ((*memory)->pid_loaded[i] == pid)
-                    {
-                        (*memory)->pid_loaded[i] = UINT32_MAX;
-                        break;
-                    }
-                }
-            }
-            update_mem_usage(memory);
-            break;
+    //First occurence is the lowest frame held by the process
+    for (uint32_t i = 0; i < set->n_frames; i++)
+    {
+        if (set->frames[i] < first)
+        {
+            first = set->frames[i];
         }
     }
 
-    return ret_pack;
+    mark_evicted(*memory, first);
+    release_frame(*memory, first);
+
+    return first;
 }
 
 /*
@@ -383,46 +362,29 @@ memory, struct memory_t **, pointer to the memory_t * to allow modification
 pid, uint32_t, process id of evictee :(
 
 @return
-uint32_t *, an array of memory space address freed, due to the eviction
+uint32_t, number of memory space addresses freed and marked evicted
 */
-uint32_t *evict_from_memory(struct memory_t **memory, uint32_t pid)
+uint32_t evict_from_memory(struct memory_t **memory, uint32_t pid)
 {
-    uint32_t counter = 0;
-    uint32_t *evicted_mem_addr = NULL;
-
-    //Remove pid from book keeping
-    for (uint32_t i = 0; i < (*memory)->n_total_proc; i++)
-    {
-        if ((*memory)->pid_loaded[i] == pid)
-        {
-            (*memory)->pid_loaded[i] = UINT32_MAX;
-            break;
-        }
-    }
+    struct resident_set_t *set = find_resident_set((*memory)->resident, pid);
+    uint32_t counter = set ? set->n_frames : 0;
 
-    //Start evicting process' pages from memory
-    for (uint32_t i = 0; i < (*memory)->n_total_pages; i++)
+    //Start evicting process' pages from memory, from the end of the set so releasing
+    //never moves a frame that is still to come. The last release drops the set, and the
+    //process from the loaded order
+    for (uint32_t i = counter; i > 0; i--)
     {
-        if ((*memory)->main_memory[i] == pid)
-        {
-            //Init array
-            if (!evicted_mem_addr)
-            {
-                evicted_mem_addr = create_uint32_array((*memory)->n_total_pages, UINT32_MAX);
-            }
-            evicted_mem_addr[counter] = i;
-            counter += 1;
-            (*memory)->main_memory[i] = UINT32_MAX;
-        }
+        mark_evicted(*memory, set->frames[i - 1]);
+        release_frame(*memory, set->frames[i - 1]);
     }
-    update_mem_usage(memory);
 
-    return evicted_mem_addr;
+    return counter;
 }
 
 /*
-Finds the process to evict based on least recently used algorithm
-!! ASSUMES BY DEFAULT THE BOOKKEEPING PID IS EQUIVALENT TO RUNNING PROCESSES
+Finds the process to evict based on least recently used algorithm, the last process
+in the loaded order
+!! A PROCESS IS IN THE LOADED ORDER WHILE IT HOLDS ANY PAGE FRAME
 @params
 memory, struct memory_t *, the memory representation
 
@@ -431,23 +393,18 @@ uint32_t, the process ID chosen to be evicted (UINT32_MAX IF NONE)
 */
 uint32_t find_evictee_lru(struct memory_t *memory)
 {
-    for (uint32_t i = 0; i < memory->n_total_proc; i++)
-    {
-        //Reach end of running processes list
-        if (memory->pid_loaded[i] == UINT32_MAX)
-        {   
-            //singleton
-            if (i == 0)
-            {
-                return memory->pid_loaded[i];
-            }
-            
-            return memory->pid_loaded[i-1];
-        }
+    return memory->resident->lru_tail;
+}
 
-    }
-    //Not supposed to be here
-    return UINT32_MAX;
+/*
+Moves the first process in the loaded order to the end, as the run queue does under
+Round-Robin
+@params
+memory, struct memory_t **, pointer to the memory_t * to allow modification
+*/
+void rotate_loaded(struct memory_t **memory)
+{
+    rotate_resident((*memory)->resident);
 }
 
 /*
@@ -460,17 +417,7 @@ uint32_t, number of unused memory pages
 */
 uint32_t count_unused_mem(struct memory_t *memory)
 {
-    uint32_t unused_pages = 0;
-
-    for (uint32_t i = 0; i < memory->n_total_pages; i++)
-    {
-        if (memory->main_memory[i] == UINT32_MAX)
-        {
-            unused_pages += 1;
-        }
-    }
-
-    return unused_pages;
+    return memory->n_free_pages;
 }
 
 /*
@@ -484,17 +431,7 @@ uint32_t, number of pages that corresponds to the PID, if any
 */
 uint32_t has_been_loaded(struct memory_t *memory, uint32_t pid)
 {
-    uint32_t count = 0;
-
-    for (uint32_t i = 0; i < memory->n_total_pages; i++)
-    {
-        //Found a page allocated to the process
-        if (memory->main_memory[i] == pid)
-        {
-            count += 1;
-        }
-    }
-    return count;
+    return count_resident(memory->resident, pid);
 }
 
 /*
@@ -506,81 +443,322 @@ pid, uint32_t, Process ID of executed process
 */
 void set_reference_bits(struct memory_t **memory, uint32_t flag, uint32_t pid)
 {
-    for (uint32_t i = 0; i < (*memory)->n_total_pages; i++)
+    struct resident_set_t *set = find_resident_set((*memory)->resident, pid);
+
+    for (uint32_t i = 0; set && i < set->n_frames; i++)
     {
-        if ((*memory)->main_memory[i] == pid)
+        uint32_t frame = set->frames[i];
+        uint64_t bit = UINT64_C(1) << (frame % BITS_PER_FRAME_WORD);
+
+        if (flag)
+        {
+            (*memory)->reference_bits[frame / BITS_PER_FRAME_WORD] |= bit;
+        }
+        else
         {
-            (*memory)->reference_bit[i] = flag;
+            (*memory)->reference_bits[frame / BITS_PER_FRAME_WORD] &= ~bit;
         }
     }
 }
 
 /*
-Updates pid into memory and load pages into the main memory
+Loads pages into the main memory, a process joins the loaded order with its first page
 !! ASSUMES AVAILABLE FREE SPACE TO LOAD PAGES INTO MEMORY
 @params
 memory, struct memory_t **, pointer to the memory_t * to allow modification
 pid, uint32_t, Process ID of requesting process
-pages, uint32_t, number of pages to load
-mem_addr, uint32_t *, Must be initialised, stores assigned memory addresses
+pages, uint32_t, number of pages to load, their addresses are kept in loaded_addr
+*/
+void add_into_memory(struct memory_t **memory, uint32_t pid, uint32_t pages)
+{
+    uint32_t n = 0;
+
+    //Words below free_lo have no free frame, skips the ones filled since
+    while ((*memory)->free_lo * BITS_PER_FRAME_WORD < (*memory)->n_total_pages &&
+     !(*memory)->free_frames[(*memory)->free_lo])
+    {
+        (*memory)->free_lo += 1;
+    }
+
+    //Insert pages into the lowest free frames, a whole word of frames at a time
+    for (uint32_t w = (*memory)->free_lo; pages > 0 && w * BITS_PER_FRAME_WORD < (*memory)->n_total_pages; w++)
+    {
+        while (pages > 0 && (*memory)->free_frames[w])
+        {
+            uint32_t i = w * BITS_PER_FRAME_WORD + __builtin_ctzll((*memory)->free_frames[w]);
+
+            claim_frame(*memory, i, pid);
+            (*memory)->loaded_addr[n] = i;
+            pages -= 1;
+            n += 1;
+        }
+    }
+
+    (*memory)->n_loaded_addr = n;
+}
+
+/*
+Percentage of main memory in use, rounded up
+!! SINGLE PRECISION AS IN THE REFERENCE TRANSCRIPTS, AN EXACT RATIO SUCH AS 7 OF 25 FRAMES
+!! CAN ROUND UP TO 29
+@params
+memory, struct memory_t *, the memory
 
 @return
-uint32_t *, array of allocated memory addresses
+int, memory usage in percent
 */
-uint32_t *add_into_memory(struct memory_t **memory, uint32_t pid, uint32_t pages, uint32_t *mem_addr)
+int memory_usage(struct memory_t *memory)
 {
-    uint32_t n = 0;
+    uint32_t used = memory->n_total_pages - memory->n_free_pages;
+    float usage = 0.0f;
 
-    //Insert loaded pid for book keeping
-    for (uint32_t i = 0; i < (*memory)->n_total_proc; i++)
+    if (memory->n_total_pages == 0)
     {
-        if ((*memory)->pid_loaded[i] == UINT32_MAX)
+        return 0;
+    }
+
+    usage = ceil( (((float)used) / ((float)memory->n_total_pages)) * 100.0 );
+
+    return (int) usage;
+}
+
+/*
+Creates a bitmap with a bit per page frame
+@params
+n_pages, uint32_t, number of page frames in main memory
+fill, uint64_t, value of every word
+past_end, uint64_t, value of the bits past the last frame
+
+@return
+uint64_t *, the bitmap
+*/
+uint64_t *create_frame_bitmap(uint32_t n_pages, uint64_t fill, uint64_t past_end)
+{
+    uint32_t n_words = (n_pages + BITS_PER_FRAME_WORD - 1) / BITS_PER_FRAME_WORD;
+    uint64_t *bitmap = malloc(sizeof(uint64_t) * (n_words ? n_words : 1));
+    uint64_t tail = 0;
+
+    if (!bitmap)
+    {
+        fprintf(stderr, "Malloc failed!\n");
+        exit(1);
+    }
+
+    for (uint32_t w = 0; w < n_words; w++)
+    {
+        bitmap[w] = fill;
+    }
+    if (n_pages % BITS_PER_FRAME_WORD)
+    {
+        tail = (UINT64_C(1) << (n_pages % BITS_PER_FRAME_WORD)) - 1;
+        bitmap[n_words - 1] = (fill & tail) | (past_end & ~tail);
+    }
+
+    return bitmap;
+}
+
+/*
+Sets or clears the bits of every frame of a process in the owned frame bitmap
+@params
+memory, struct memory_t *, memory representation
+pid, uint32_t, the Process ID
+flag, uint32_t, 0 or 1
+*/
+void mark_owned_frames(struct memory_t *memory, uint32_t pid, uint32_t flag)
+{
+    struct resident_set_t *set = find_resident_set(memory->resident, pid);
+
+    for (uint32_t i = 0; set && i < set->n_frames; i++)
+    {
+        uint32_t frame = set->frames[i];
+        uint64_t bit = UINT64_C(1) << (frame % BITS_PER_FRAME_WORD);
+
+        if (flag)
+        {
+            memory->owned_frames[frame / BITS_PER_FRAME_WORD] |= bit;
+        }
+        else
         {
-            (*memory)->pid_loaded[i] = pid;
-            break;
+            memory->owned_frames[frame / BITS_PER_FRAME_WORD] &= ~bit;
         }
     }
+}
 
-    //Insert pages into memory
-    for (uint32_t i = 0; i < (*memory)->n_total_pages; i++)
+/*
+Finds the first frame, from the clock hand on, not marked owned and without a reference
+bit, then moves the hand past it. Reference bits of the frames passed over are cleared,
+a word of frames at a time
+@params
+memory, struct memory_t *, memory representation, with owned frames marked
+
+@return
+uint32_t, index of the page frame, UINT32_MAX if there are no frames or every frame is owned
+*/
+uint32_t find_second_chance(struct memory_t *memory)
+{
+    uint32_t n_words = (memory->n_total_pages + BITS_PER_FRAME_WORD - 1) / BITS_PER_FRAME_WORD;
+    uint32_t w = memory->clock_hand / BITS_PER_FRAME_WORD;
+    uint64_t in_range = UINT64_MAX << (memory->clock_hand % BITS_PER_FRAME_WORD);
+    uint64_t candidates = 0, unreferenced = 0, seen = 0;
+    uint32_t bit = 0, victim = 0, n_visited = 0;
+
+    if (n_words == 0)
+    {
+        return UINT32_MAX;
+    }
+
+    while (1)
     {
-        if ((*memory)->main_memory[i] == UINT32_MAX)
+        //One lap, plus the frames behind the hand in its word, found nothing to evict
+        if (n_visited > n_words && !seen)
         {
-            (*memory)->main_memory[i] = pid;
-            mem_addr[n] = i;
-            pages -= 1;
-            n += 1;
+            return UINT32_MAX;
         }
+        n_visited += 1;
 
-        //breaks after all pages inserted into memory
-        if (pages <= 0)
+        candidates = ~memory->owned_frames[w] & in_range;
+        unreferenced = candidates & ~memory->reference_bits[w];
+        seen |= candidates;
+
+        if (unreferenced)
         {
-            break;
+            bit = __builtin_ctzll(unreferenced);
+            memory->reference_bits[w] &= ~(candidates & ((UINT64_C(1) << bit) - 1));
+            victim = w * BITS_PER_FRAME_WORD + bit;
+            memory->clock_hand = victim + 1 < memory->n_total_pages ? victim + 1 : 0;
+            return victim;
         }
+        //Every candidate in the word had a second chance
+        memory->reference_bits[w] &= ~candidates;
+
+        //Frames behind the hand in its word are reached again on wrapping around
+        in_range = UINT64_MAX;
+        w = w + 1 < n_words ? w + 1 : 0;
     }
+}
 
-    update_mem_usage(memory);
-    
-    return mem_addr;
+/*
+Assigns a page frame to a process, taking it from its previous owner if any
+@params
+memory, struct memory_t *, memory representation
+frame, uint32_t, index of the page frame
+pid, uint32_t, Process ID of the new owner
+*/
+void claim_frame(struct memory_t *memory, uint32_t frame, uint32_t pid)
+{
+    uint32_t owner = memory->main_memory[frame];
+
+    if (owner == UINT32_MAX)
+    {
+        memory->free_frames[frame / BITS_PER_FRAME_WORD] &= ~(UINT64_C(1) << (frame % BITS_PER_FRAME_WORD));
+        memory->n_free_pages -= 1;
+
+        //With no free frame left, the next one released sets free_lo exactly
+        if (memory->n_free_pages == 0)
+        {
+            memory->free_lo = (memory->n_total_pages + BITS_PER_FRAME_WORD - 1) / BITS_PER_FRAME_WORD;
+        }
+    }
+    else
+    {
+        resident_remove(memory->resident, owner, frame);
+    }
+    memory->main_memory[frame] = pid;
+    resident_add(memory->resident, pid, frame);
 }
 
 /*
-Updates memory usage in the main memory
-!! Modifies in array
+Frees a page frame owned by a process
+!! ASSUMES FRAME IS OWNED
 @params
-memory, struct memory_t **, pointer to the memory_t * to allow modification
+memory, struct memory_t *, memory representation
+frame, uint32_t, index of the page frame
 */
-void update_mem_usage(struct memory_t **memory)
+void release_frame(struct memory_t *memory, uint32_t frame)
 {
-    int free_space = 0;
-    float usage = 0.0f;
-    int total = (int) (*memory)->n_total_pages;
+    resident_remove(memory->resident, memory->main_memory[frame], frame);
+    memory->main_memory[frame] = UINT32_MAX;
+    memory->free_frames[frame / BITS_PER_FRAME_WORD] |= UINT64_C(1) << (frame % BITS_PER_FRAME_WORD);
+    memory->n_free_pages += 1;
+    if (frame / BITS_PER_FRAME_WORD < memory->free_lo)
+    {
+        memory->free_lo = frame / BITS_PER_FRAME_WORD;
+    }
+}
 
-    free_space = (int) count_unused_mem(*memory);
-    
-    usage = ceil( (((float)(total - free_space)) / ((float)total)) * 100.0 );
-    
-    (*memory)->mem_usage = usage;
+/*
+Marks a page frame as evicted in the current eviction episode
+@params
+memory, struct memory_t *, memory representation
+frame, uint32_t, index of the page frame
+*/
+void mark_evicted(struct memory_t *memory, uint32_t frame)
+{
+    uint32_t w = frame / BITS_PER_FRAME_WORD;
+
+    memory->evicted_frames[w] |= UINT64_C(1) << (frame % BITS_PER_FRAME_WORD);
+    memory->n_evicted += 1;
+    if (w < memory->evicted_lo)
+    {
+        memory->evicted_lo = w;
+    }
+    if (w > memory->evicted_hi)
+    {
+        memory->evicted_hi = w;
+    }
+}
+
+/*
+Adds the frames marked evicted to make room for a load to the running total, frames
+freed by a finished process are not counted
+@params
+memory, struct memory_t *, memory representation
+n_free, uint32_t, frames marked evicted that were free, listed but not counted
+*/
+void count_load_evictions(struct memory_t *memory, uint32_t n_free)
+{
+    memory->total_evicted += memory->n_evicted - n_free;
+}
+
+/*
+Lists the frames marked evicted in address order and ends the eviction episode,
+only the words between the lowest and highest marked frame are visited
+!! THE ARRAY IS OWNED BY THE MEMORY AND REUSED BY THE NEXT EPISODE
+@params
+memory, struct memory_t *, memory representation
+
+@return
+uint32_t *, array of the evicted addresses ending in UINT32_MAX, NULL if none
+*/
+uint32_t *collect_evicted(struct memory_t *memory)
+{
+    uint32_t *evicted = memory->evicted_addr;
+    uint32_t n = 0;
+    uint64_t word = 0;
+
+    if (memory->n_evicted == 0)
+    {
+        return NULL;
+    }
+
+    for (uint32_t w = memory->evicted_lo; w <= memory->evicted_hi; w++)
+    {
+        word = memory->evicted_frames[w];
+        while (word)
+        {
+            evicted[n] = w * BITS_PER_FRAME_WORD + __builtin_ctzll(word);
+            n += 1;
+            word &= word - 1;
+        }
+        memory->evicted_frames[w] = 0;
+    }
+    evicted[n] = UINT32_MAX;
+
+    memory->n_evicted = 0;
+    memory->evicted_lo = UINT32_MAX;
+    memory->evicted_hi = 0;
+
+    return evicted;
 }
 
 /*
@@ -590,9 +768,14 @@ memory, struct memory_t *, the memory
 */
 void free_memory(struct memory_t *memory)
 {
-    free(memory->pid_loaded);
     free(memory->main_memory);
-    free(memory->reference_bit);
+    free(memory->loaded_addr);
+    free(memory->evicted_frames);
+    free(memory->evicted_addr);
+    free(memory->reference_bits);
+    free(memory->owned_frames);
+    free(memory->free_frames);
+    free_resident_table(memory->resident);
     
     free(memory);
 }
@@ -0,0 +1,603 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "../include/parser.h"
+#include "../include/trace.h"
+
+//Constants
+#define N_COLUMNS 4
+#define SIZE_READ_CHUNK 65536
+#define SIZE_WINDOW_AHEAD 4096
+#define SIZE_RELEASE_WINDOW (64 * 1024 * 1024)
+#define SIZE_SIMPLE_LINE 32
+#define MAX_WORD_DIGITS 8
+
+//Checks if a character separates columns within a line
+#define IS_BLANK(c) ((c) == ' ' || (c) == '\t' || (c) == '\r' || (c) == '\v' || (c) == '\f')
+
+//Every byte of a word set to the same value, for scanning 8 characters at a time
+#define BYTES_OF(b) (UINT64_C(0x0101010101010101) * (b))
+
+//Functions
+void refill_window(struct parser_t *);
+void fill_window(struct parser_t *);
+void grow_window(struct parser_t *);
+int window_has_entry(struct parser_t *);
+void release_parsed_pages(struct parser_t *);
+void release_range(const void *, const void *);
+void parse_error(struct parser_t *, size_t, char *);
+const char *scan_unsigned(const char *, const char *, uint64_t *);
+uint32_t scan_simple_line(const char *, uint64_t *);
+uint64_t load_word(const char *);
+uint64_t word_to_uint(uint64_t, uint32_t);
+
+/*
+Opens a parser over the whole input file, mapping it into memory when possible
+!! BINARY TRACES ARE DETECTED BY THEIR HEADER AND READ STRAIGHT FROM THEIR COLUMNS
+!! FALLS BACK TO READING THE FILE THROUGH A WINDOW IF IT CANNOT BE MAPPED (E.G. A PIPE),
+!! ONLY A BINARY TRACE, READ ALONG EVERY COLUMN AT ONCE, IS READ WHOLE
+!! CLOSES THE FILE WHEN THE PARSER IS CLOSED
+@params
+fptr, FILE *, the input file
+
+@return
+struct parser_t *, the opened parser
+*/
+struct parser_t *open_parser(FILE *fptr)
+{
+    struct parser_t *parser = malloc(sizeof(struct parser_t));
+    struct stat st;
+
+    if (!parser)
+    {
+        fprintf(stderr, "Malloc failed!\n");
+        exit(1);
+    }
+
+    memset(parser, 0, sizeof(struct parser_t));
+    parser->file = fptr;
+    parser->line = 1;
+
+    //Map regular files directly, the kernel pages them in as they are scanned
+    if (fstat(fileno(fptr), &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0)
+    {
+        void *data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fileno(fptr), 0);
+
+        if (data != MAP_FAILED)
+        {
+            madvise(data, st.st_size, MADV_SEQUENTIAL);
+            parser->data = data;
+            parser->size = st.st_size;
+            parser->mapped = 1;
+        }
+    }
+
+    if (!parser->mapped)
+    {
+        refill_window(parser);
+        if (parser->size >= 4 && memcmp(parser->data, TRACE_MAGIC, 4) == 0)
+        {
+            read_whole_file(parser);
+        }
+    }
+    parser->trace = open_trace(parser->data, parser->size);
+
+    return parser;
+}
+
+/*
+Reads the rest of the input file into the window, growing it to fit, for binary traces
+that cannot be mapped and for inputs that are read twice
+!! ONLY BEFORE ANYTHING IS PARSED, THE WINDOW THEN HOLDS THE WHOLE INPUT
+@params
+parser, struct parser_t *, the parser
+*/
+void read_whole_file(struct parser_t *parser)
+{
+    while (!parser->eof)
+    {
+        if (parser->size == parser->capacity)
+        {
+            grow_window(parser);
+        }
+        fill_window(parser);
+    }
+}
+
+/*
+Moves the unparsed input to the front of the window and reads more of the file after it.
+The line being parsed is kept whole so errors still report its column
+!! THE WINDOW ONLY GROWS IF A SINGLE LINE DOES NOT FIT IN IT
+@params
+parser, struct parser_t *, the parser, reading through a window
+*/
+void refill_window(struct parser_t *parser)
+{
+    size_t keep = parser->line_start;
+
+    //The first byte of the window is taken as the start of the input, pos must not land on it
+    if (keep == parser->pos && keep > 0)
+    {
+        keep -= 1;
+    }
+
+    if (keep > 0)
+    {
+        memmove(parser->data, parser->data + keep, parser->size - keep);
+        parser->window_offset += keep;
+        parser->size -= keep;
+        parser->pos -= keep;
+        parser->line_start -= keep;
+    }
+
+    if (parser->size == parser->capacity)
+    {
+        grow_window(parser);
+    }
+    fill_window(parser);
+}
+
+/*
+Reads from the file until the window is full or the file ends
+@params
+parser, struct parser_t *, the parser, reading through a window
+*/
+void fill_window(struct parser_t *parser)
+{
+    size_t n_read = 0;
+
+    while (parser->size < parser->capacity && !parser->eof)
+    {
+        n_read = fread(parser->data + parser->size, 1, parser->capacity - parser->size, parser->file);
+        parser->size += n_read;
+        parser->eof = (n_read == 0);
+    }
+}
+
+/*
+Doubles the window, SIZE_READ_CHUNK to begin with
+@params
+parser, struct parser_t *, the parser, reading through a window
+*/
+void grow_window(struct parser_t *parser)
+{
+    parser->capacity = parser->capacity ? parser->capacity * 2 : SIZE_READ_CHUNK;
+    parser->data = realloc(parser->data, parser->capacity);
+
+    if (!parser->data)
+    {
+        fprintf(stderr, "Malloc failed!\n");
+        exit(1);
+    }
+}
+
+/*
+Checks if the next process entry lies whole in the window, that is the line of its first
+character is ended by a newline in the window
+@params
+parser, struct parser_t *, the parser, reading through a window
+
+@return
+int, 1 if the entry can be parsed from the window, 0 if more must be read first
+*/
+int window_has_entry(struct parser_t *parser)
+{
+    const char *curr = parser->data + parser->pos;
+    const char *end = parser->data + parser->size;
+
+    while (curr < end && (IS_BLANK(*curr) || *curr == '\n'))
+    {
+        curr += 1;
+    }
+
+    return curr < end && memchr(curr, '\n', end - curr) != NULL;
+}
+
+/*
+Parses the next process entry, four whitespace separated unsigned integer columns
+on a single line: arrival time, process ID, memory required and time required
+!! BLANK LINES ARE SKIPPED, ANY OTHER MALFORMED LINE IS REPORTED WITH ITS LINE AND
+!! COLUMN AND EXITS
+@params
+parser, struct parser_t *, the parser
+time, uint32_t *, set to the arrival time
+pid, uint32_t *, set to the process ID
+mem, uint32_t *, set to the memory required
+time_fin, uint32_t *, set to the time required
+
+@return
+int, 1 if a process entry was parsed, 0 at end of input
+*/
+int parse_process_line(struct parser_t *parser, uint32_t *time, uint32_t *pid, uint32_t *mem, uint32_t *time_fin)
+{
+    uint32_t *columns[N_COLUMNS] = {time, pid, mem, time_fin};
+    uint64_t values[N_COLUMNS];
+    const char *data = NULL;
+    const char *curr = NULL;
+    const char *end = NULL;
+
+    //Inputs read through a window are refilled before they run short, so the fast path
+    //keeps its lookahead and no entry is cut at the end of the window
+    if (!parser->mapped && !parser->trace)
+    {
+        while (!parser->eof
+         && (parser->size - parser->pos < SIZE_WINDOW_AHEAD || !window_has_entry(parser)))
+        {
+            refill_window(parser);
+        }
+    }
+    data = parser->data;
+    curr = data + parser->pos;
+    end = data + parser->size;
+
+    //Binary traces need no parsing, pos is the index of the next process
+    if (parser->trace)
+    {
+        if (parser->pos >= parser->trace->n_processes)
+        {
+            return 0;
+        }
+        *time = trace_column(parser->trace, TRACE_ARRIVAL)[parser->pos];
+        *pid = trace_column(parser->trace, TRACE_PID)[parser->pos];
+        *mem = trace_column(parser->trace, TRACE_MEMORY)[parser->pos];
+        *time_fin = trace_column(parser->trace, TRACE_TIME)[parser->pos];
+        parser->pos += 1;
+        release_parsed_pages(parser);
+
+        return 1;
+    }
+
+    //Most lines are short, single spaced and follow the last one right after its newline,
+    //nothing is read past the end of a file without a trailing newline
+    if (parser->pos < parser->size && (parser->pos == 0 || *curr == '\n'))
+    {
+        const char *line = parser->pos == 0 ? curr : curr + 1;
+        uint32_t length = 0;
+
+        if (end - line >= SIZE_SIMPLE_LINE + MAX_WORD_DIGITS && (length = scan_simple_line(line, values)) != 0)
+        {
+            if (line != curr)
+            {
+                parser->line += 1;
+                parser->line_start = line - data;
+            }
+            for (int i=0; i < N_COLUMNS; i++)
+            {
+                *columns[i] = (uint32_t)values[i];
+            }
+
+            parser->pos = line + length - data;
+            release_parsed_pages(parser);
+
+            return 1;
+        }
+    }
+
+    //Skip whitespace and blank lines up to the next entry
+    while (curr < end && (IS_BLANK(*curr) || *curr == '\n'))
+    {
+        if (*curr == '\n')
+        {
+            parser->line += 1;
+            parser->line_start = curr + 1 - data;
+        }
+        curr += 1;
+    }
+
+    if (curr == end)
+    {
+        parser->pos = curr - data;
+        return 0;
+    }
+
+    for (int i=0; i < N_COLUMNS; i++)
+    {
+        const char *start = curr;
+        uint64_t value = 0;
+
+        //Columns after the first must be separated by whitespace on the same line
+        if (i > 0)
+        {
+            while (curr < end && IS_BLANK(*curr))
+            {
+                curr += 1;
+            }
+            if (curr == start && curr < end && *curr != '\n')
+            {
+                parse_error(parser, curr - data, "expected whitespace between columns");
+            }
+            start = curr;
+        }
+
+        curr = scan_unsigned(curr, end, &value);
+
+        //A line that ends early is short of columns, anything else is not a number
+        if (curr == start && i > 0 && (curr == end || *curr == '\n'))
+        {
+            parse_error(parser, curr - data, "expected 4 columns");
+        }
+        if (curr == start)
+        {
+            parse_error(parser, curr - data, "expected an unsigned integer");
+        }
+        if (value > UINT32_MAX)
+        {
+            parse_error(parser, start - data, "value does not fit in 32 bits");
+        }
+        *columns[i] = (uint32_t)value;
+    }
+
+    //Only trailing whitespace may follow the last column
+    while (curr < end && IS_BLANK(*curr))
+    {
+        curr += 1;
+    }
+    if (curr < end && *curr != '\n')
+    {
+        parse_error(parser, curr - data, "expected end of line after 4 columns");
+    }
+
+    parser->pos = curr - data;
+    release_parsed_pages(parser);
+
+    return 1;
+}
+
+/*
+Parses a line of four columns that are each 1 to 8 digits long, separated by single spaces
+and ended by a newline, all within SIZE_SIMPLE_LINE bytes. The positions of every non-digit
+are found at once, so each column is converted without waiting on the one before it
+!! READS SIZE_SIMPLE_LINE + MAX_WORD_DIGITS BYTES FROM LINE, WHATEVER THE LENGTH OF THE LINE
+@params
+line, const char *, first character of the line
+values, uint64_t *, set to the four columns
+
+@return
+uint32_t, offset of the newline ending the line, 0 if the line is not that simple
+*/
+uint32_t scan_simple_line(const char *line, uint64_t *values)
+{
+    uint32_t non_digits = 0, start = 0, stop = 0, n_digits = 0;
+    uint64_t word = 0;
+
+    //One bit per byte, set for every non-digit
+    for (int w = 0; w < SIZE_SIMPLE_LINE / 8; w++)
+    {
+        word = load_word(line + 8 * w) ^ BYTES_OF(0x30);
+        word = ((((word & BYTES_OF(0x7f)) + BYTES_OF(0x76)) | word) & BYTES_OF(0x80)) >> 7;
+        non_digits |= (uint32_t) ((word * UINT64_C(0x0102040810204080)) >> 56) << (8 * w);
+    }
+
+    for (int i=0; i < N_COLUMNS; i++)
+    {
+        if (!non_digits)
+        {
+            return 0;
+        }
+        stop = __builtin_ctz(non_digits);
+        non_digits &= non_digits - 1;
+        n_digits = stop - start;
+
+        //Empty or over long columns and any other separator take the general path
+        if (n_digits - 1 >= MAX_WORD_DIGITS || line[stop] != (i == N_COLUMNS - 1 ? '\n' : ' '))
+        {
+            return 0;
+        }
+        values[i] = word_to_uint(load_word(line + start) ^ BYTES_OF(0x30), n_digits);
+        start = stop + 1;
+    }
+
+    return stop;
+}
+
+/*
+Scans the digits of an unsigned integer. Numbers of up to 7 digits with 8 bytes of input
+left are converted in one word, anything longer a digit at a time
+!! STOPS ACCUMULATING ONCE OUT OF RANGE, THE CALLER CHECKS VALUE AGAINST UINT32_MAX
+@params
+curr, const char *, first character of the number
+end, const char *, end of the input
+value, uint64_t *, set to the number, 0 if there are no digits
+
+@return
+const char *, the first character after the digits
+*/
+const char *scan_unsigned(const char *curr, const char *end, uint64_t *value)
+{
+    uint64_t word = 0, non_digits = 0;
+    unsigned digit = 0;
+
+    *value = 0;
+
+    if (end - curr >= MAX_WORD_DIGITS)
+    {
+        //Digits become 0 to 9, a byte is a digit if it stays below 10
+        word = load_word(curr) ^ BYTES_OF(0x30);
+        non_digits = (((word & BYTES_OF(0x7f)) + BYTES_OF(0x76)) | word) & BYTES_OF(0x80);
+
+        if (non_digits)
+        {
+            *value = word_to_uint(word, __builtin_ctzll(non_digits) / 8);
+            return curr + __builtin_ctzll(non_digits) / 8;
+        }
+    }
+
+    while (curr < end && (digit = (unsigned char)*curr - '0') < 10)
+    {
+        if (*value <= UINT32_MAX)
+        {
+            *value = *value * 10 + digit;
+        }
+        curr += 1;
+    }
+
+    return curr;
+}
+
+/*
+Loads 8 characters into a word, the first character in the lowest byte
+@params
+curr, const char *, first character
+
+@return
+uint64_t, the word
+*/
+uint64_t load_word(const char *curr)
+{
+    uint64_t word = 0;
+
+    memcpy(&word, curr, 8);
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    word = __builtin_bswap64(word);
+#endif
+
+    return word;
+}
+
+/*
+Converts the leading digits of a word, by SWAR
+@params
+word, uint64_t, loaded characters with '0' already taken off each byte
+n_digits, uint32_t, number of leading bytes that are digits, 0 to 8
+
+@return
+uint64_t, the number, 0 if there are no digits
+*/
+uint64_t word_to_uint(uint64_t word, uint32_t n_digits)
+{
+    if (n_digits == 0)
+    {
+        return 0;
+    }
+
+    //Leading zero bytes make the number 8 digits long, then pairs of digits, pairs of
+    //pairs and halves are combined
+    word <<= 8 * (8 - n_digits);
+    word = ((word & BYTES_OF(0x0f)) * 2561) >> 8;
+    word = ((word & UINT64_C(0x00ff00ff00ff00ff)) * 6553601) >> 16;
+
+    return ((word & UINT64_C(0x0000ffff0000ffff)) * UINT64_C(42949672960001)) >> 32;
+}
+
+/*
+Drops the mapped pages that have already been parsed so a long trace does not
+stay resident for the whole simulation
+@params
+parser, struct parser_t *, the parser
+*/
+void release_parsed_pages(struct parser_t *parser)
+{
+    if (!parser->mapped)
+    {
+        return;
+    }
+
+    //Binary traces are read along every column at once, release each column's prefix
+    if (parser->trace)
+    {
+        if ((parser->pos - parser->released) * sizeof(uint32_t) < SIZE_RELEASE_WINDOW)
+        {
+            return;
+        }
+        for (int i=0; i < N_TRACE_COLUMNS; i++)
+        {
+            const uint32_t *column = trace_column(parser->trace, i);
+
+            release_range(column + parser->released, column + parser->pos);
+        }
+        parser->released = parser->pos;
+    }
+    else if (parser->line_start - parser->released >= SIZE_RELEASE_WINDOW)
+    {
+        release_range(parser->data + parser->released, parser->data + parser->line_start);
+        parser->released = parser->line_start;
+    }
+}
+
+/*
+Drops the mapped pages lying entirely inside a range of the input data
+@params
+from, const void *, start of the range
+to, const void *, end of the range, exclusive
+*/
+void release_range(const void *from, const void *to)
+{
+    uintptr_t page_size = sysconf(_SC_PAGESIZE);
+    uintptr_t start = ((uintptr_t)from + page_size - 1) & ~(page_size - 1);
+    uintptr_t end = (uintptr_t)to & ~(page_size - 1);
+
+    if (end > start)
+    {
+        madvise((void *)start, end - start, MADV_DONTNEED);
+    }
+}
+
+/*
+Moves a parser back to the start of its input, for inputs that are read twice
+!! AN INPUT READ THROUGH A WINDOW THAT HAS MOVED ON MUST BE SEEKABLE, EXITS IF IT IS A PIPE
+@params
+parser, struct parser_t *, the parser
+*/
+void rewind_parser(struct parser_t *parser)
+{
+    //The window no longer holds the start of the input, read it again
+    if (!parser->mapped && parser->window_offset > 0)
+    {
+        if (fseek(parser->file, 0, SEEK_SET) != 0)
+        {
+            fprintf(stderr, "Input cannot be read twice, it must be a regular file!\n");
+            exit(1);
+        }
+        parser->window_offset = 0;
+        parser->size = 0;
+        parser->eof = 0;
+        fill_window(parser);
+    }
+    parser->pos = 0;
+    parser->released = 0;
+    parser->line_start = 0;
+    parser->line = 1;
+}
+
+/*
+Reports malformed input with its 1-based line and column, then exits
+!! THE TRANSCRIPT WRITER, IF ANY, IS DRAINED AND FLUSHED FIRST
+@params
+parser, struct parser_t *, the parser
+pos, size_t, offset of the offending character
+message, char *, description of what was expected
+*/
+void parse_error(struct parser_t *parser, size_t pos, char *message)
+{
+    if (parser->transcript)
+    {
+        close_writer(parser->transcript);
+    }
+    fprintf(stderr, "Malformed input at line %"PRIu32", column %zu: %s\n",
+    parser->line, pos - parser->line_start + 1, message);
+    exit(1);
+}
+
+/*
+Closes a parser, unmapping or freeing its data and closing the input file
+@params
+parser, struct parser_t *, the parser
+*/
+void close_parser(struct parser_t *parser)
+{
+    if (parser->mapped)
+    {
+        munmap(parser->data, parser->size);
+    }
+    else
+    {
+        free(parser->data);
+    }
+    fclose(parser->file);
+    free(parser);
+}
@@ -0,0 +1,115 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "../include/policy.h"
+#include "../include/utilities.h"
+
+//Every known policy, matched on name
+struct sched_policy_t *sched_policies[] = {&sched_first_come, &sched_round_robin, &sched_shortest_job, NULL};
+struct mem_policy_t *mem_policies[] = {&mem_unlimited, &mem_swapping, &mem_virtual, &mem_second_chance, &mem_clock, NULL};
+
+/*
+Finds the scheduling policy for an -a option
+@params
+name, char *, name of scheduling algorithm, i.e. "rr"
+
+@return
+struct sched_policy_t *, the policy, NULL if unknown
+*/
+struct sched_policy_t *find_sched_policy(char *name)
+{
+    for (int i = 0; sched_policies[i] != NULL; i++)
+    {
+        if (strcmp(sched_policies[i]->name, name) == 0)
+        {
+            return sched_policies[i];
+        }
+    }
+    return NULL;
+}
+
+/*
+Finds the memory policy for an -m option
+@params
+name, char *, name of memory allocation, i.e. "cm"
+
+@return
+struct mem_policy_t *, the policy, NULL if unknown
+*/
+struct mem_policy_t *find_mem_policy(char *name)
+{
+    for (int i = 0; mem_policies[i] != NULL; i++)
+    {
+        if (strcmp(mem_policies[i]->name, name) == 0)
+        {
+            return mem_policies[i];
+        }
+    }
+    return NULL;
+}
+
+/*
+Leaves the run queue as is, the head runs next
+@params
+queue, struct run_queue_t *, the run queue
+*/
+void keep_run_order(struct run_queue_t *queue)
+{
+    (void) queue;
+}
+
+/*
+Memory hook for policies with nothing to update
+@params
+memory, struct memory_t **, unused
+process, struct process_t *, unused
+*/
+void no_memory_update(struct memory_t **memory, struct process_t *process)
+{
+    (void) memory;
+    (void) process;
+}
+
+/*
+Evicts every page of a finished process from memory and prints the EVICTED transcript
+@params
+memory, struct memory_t **, pointer to the memory_t * to allow modification
+process, struct process_t *, the finished process
+cpu_clock, uint32_t, representation of CPU clock in Seconds
+*/
+void evict_all_pages(struct memory_t **memory, struct process_t *process, uint32_t cpu_clock)
+{
+    evict_from_memory(memory, process->pid);
+    print_memory_evict((*memory)->transcript, cpu_clock, collect_evicted(*memory), (*memory)->n_total_pages);
+}
+
+/*
+Copies the addresses of the pages just loaded into the process. Its buffer is sized once
+to its page count plus one, as a load never lists more frames than that
+!! A LOAD THAT ONLY EVICTED KEEPS A SINGLE UINT32_MAX ADDRESS, AS IT IS STILL PRINTED
+@params
+memory, struct memory_t *, the memory, after a load
+process, struct process_t *, the process that was loaded
+*/
+void keep_loaded_addresses(struct memory_t *memory, struct process_t *process)
+{
+    uint32_t n = memory->n_loaded_addr ? memory->n_loaded_addr : 1;
+    uint32_t size = process->memory_required / SIZE_PER_MEM_PAGE + 1;
+
+    //A recycled slot keeps its buffer, it only grows for a process with more pages
+    if (process->memory_address_size < size)
+    {
+        process->memory_address = realloc(process->memory_address, sizeof(uint32_t) * size);
+        if (!process->memory_address)
+        {
+            fprintf(stderr, "Malloc failed!\n");
+            exit(1);
+        }
+        process->memory_address_size = size;
+    }
+
+    process->memory_address[0] = UINT32_MAX;
+    memcpy(process->memory_address, memory->loaded_addr, sizeof(uint32_t) * memory->n_loaded_addr);
+    process->n_memory_address = n;
+}
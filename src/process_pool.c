@@ -0,0 +1,153 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "../include/process_pool.h"
+#include "../include/process_scheduling.h"
+
+//Constants
+#define DEFAULT_SLAB_SIZE 1024
+#define MAX_SLAB_SIZE 65536
+
+//Functions
+void add_slab(struct process_pool_t *);
+
+/*
+Creates an empty process pool
+@params
+n_expected, uint64_t, number of processes in the trace if known, else 0, sizes the first slab
+
+@return
+struct process_pool_t *, the pool
+*/
+struct process_pool_t *init_process_pool(uint64_t n_expected)
+{
+    struct process_pool_t *pool = malloc(sizeof(struct process_pool_t));
+
+    if (!pool)
+    {
+        fprintf(stderr, "Malloc failed!\n");
+        exit(1);
+    }
+
+    pool->slabs = NULL;
+    pool->free_list = NULL;
+    pool->next_slab_size = DEFAULT_SLAB_SIZE;
+    pool->n_slots = 0;
+
+    if (n_expected > 0)
+    {
+        pool->next_slab_size = n_expected < MAX_SLAB_SIZE ? n_expected : MAX_SLAB_SIZE;
+    }
+
+    return pool;
+}
+
+/*
+Adds a new slab to the pool, each slab twice as large as the last up to MAX_SLAB_SIZE
+@params
+pool, struct process_pool_t *, the pool
+*/
+void add_slab(struct process_pool_t *pool)
+{
+    struct pool_slab_t *slab = malloc(sizeof(struct pool_slab_t));
+
+    if (!slab)
+    {
+        fprintf(stderr, "Malloc failed!\n");
+        exit(1);
+    }
+
+    slab->size = pool->next_slab_size;
+    slab->n_used = 0;
+    slab->first_slot = pool->n_slots;
+    slab->processes = malloc(sizeof(struct process_t) * slab->size);
+
+    if (!slab->processes)
+    {
+        fprintf(stderr, "Malloc failed!\n");
+        exit(1);
+    }
+
+    slab->next = pool->slabs;
+    pool->slabs = slab;
+    pool->n_slots += slab->size;
+
+    if (pool->next_slab_size < MAX_SLAB_SIZE)
+    {
+        pool->next_slab_size *= 2;
+    }
+}
+
+/*
+Takes a process from the pool, a released one if any, uninitialised other than its slot
+and its memory address buffer
+@params
+pool, struct process_pool_t *, the pool
+
+@return
+struct process_t *, the process
+*/
+struct process_t *pool_alloc(struct process_pool_t *pool)
+{
+    struct process_t *process = pool->free_list;
+    struct pool_slab_t *slab = NULL;
+
+    if (process)
+    {
+        pool->free_list = process->next;
+        return process;
+    }
+
+    if (!pool->slabs || pool->slabs->n_used == pool->slabs->size)
+    {
+        add_slab(pool);
+    }
+
+    slab = pool->slabs;
+    process = &slab->processes[slab->n_used];
+    process->slot = slab->first_slot + slab->n_used;
+    process->memory_address = NULL;
+    process->memory_address_size = 0;
+    slab->n_used += 1;
+
+    return process;
+}
+
+/*
+Gives a process back to the pool, its memory address buffer is kept for the next process
+taking the slot
+@params
+pool, struct process_pool_t *, the pool
+process, struct process_t *, the process, taken from this pool
+*/
+void pool_release(struct process_pool_t *pool, struct process_t *process)
+{
+    process->n_memory_address = 0;
+    process->next = pool->free_list;
+    pool->free_list = process;
+}
+
+/*
+Frees the pool and every process taken from it at once, released or not
+@params
+pool, struct process_pool_t *, the pool
+*/
+void free_process_pool(struct process_pool_t *pool)
+{
+    struct pool_slab_t *slab = pool->slabs;
+
+    while (slab)
+    {
+        struct pool_slab_t *next = slab->next;
+
+        //Every slot handed out owns its memory address buffer, NULL if never loaded
+        for (uint32_t i = 0; i < slab->n_used; i++)
+        {
+            free(slab->processes[i].memory_address);
+        }
+        free(slab->processes);
+        free(slab);
+        slab = next;
+    }
+    free(pool);
+}
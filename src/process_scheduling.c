@@ -6,9 +6,13 @@
 #include "../include/utilities.h"
 #include "../include/memory.h"
 
+//Constants
+#define INIT_ARRIVALS_CAPACITY 1024
+
 /*
 Creates a new process linked list head of type process_t
 @params
+pool, struct process_pool_t *, the pool to take the process from
 pid, uint32_t, the process ID
 arrival, uint32_t, the arrival time of process in Seconds
 mem_needed, uint32_t, the amount of memory needed in KB
@@ -17,15 +21,11 @@ time_to_fin, uint32_t, the required time for process to finish in Seconds
 @return
 a process_t linked list head pointer
 */
-struct process_t *create_process(uint32_t pid, uint32_t arrival, uint32_t mem_needed, uint32_t time_to_fin)
+struct process_t *create_process(struct process_pool_t *pool, uint32_t pid, uint32_t arrival, uint32_t mem_needed,
+ uint32_t time_to_fin)
 {
-    struct process_t *new_p = malloc(sizeof(struct process_t));
-
-    if (new_p == NULL)
-    {
-        fprintf(stderr, "Malloc failed!\n");
-        exit(1);
-    }
+    //The pool gives every process a dense slot, which the job heap relies on
+    struct process_t *new_p = pool_alloc(pool);
 
     new_p->pid = pid;
     new_p->arrival_time = arrival;
@@ -35,117 +35,212 @@ struct process_t *create_process(uint32_t pid, uint32_t arrival, uint32_t mem_ne
     new_p->time_last_used = 0;
     new_p->time_finished = 0;
     new_p->time_load_penalty = 0;
-    new_p->memory_address = NULL;
+    new_p->n_memory_address = 0;
     new_p->next = NULL;
+    new_p->prev = NULL;
 
     return new_p; 
 }
 
 /*
-Frees up memory used by the linked list
+Reads every arrival of the input file into columns, for workloads that share them
+!! CLOSES THE FILE
 @params
-list, struct process_t *, head of linked list to be freed
+fptr, FILE *, the input file
+
+@return
+struct arrivals_t *, the arrivals, in order of the input file
 */
-void free_list(struct process_t *list)
+struct arrivals_t *read_all_arrivals(FILE *fptr)
 {
-    struct process_t *curr = list;
+    struct arrivals_t *arrivals = malloc(sizeof(struct arrivals_t));
+    struct parser_t *parser = open_parser(fptr);
+    uint32_t values[N_TRACE_COLUMNS];
 
-    //Case for empty list
-    if (!list)
+    if (!arrivals)
     {
-        return;
+        fprintf(stderr, "Malloc failed!\n");
+        exit(1);
     }
-    
-    //Case for singleton element
-    if (list->next == NULL)
+
+    arrivals->n_processes = 0;
+    arrivals->capacity = 0;
+    for (int c = 0; c < N_TRACE_COLUMNS; c++)
     {
-        free(list->memory_address);
-        free(list);
-        return;
+        arrivals->columns[c] = NULL;
     }
-    
-    while(list != NULL)
+
+    while (parse_process_line(parser, &values[TRACE_ARRIVAL], &values[TRACE_PID], &values[TRACE_MEMORY],
+     &values[TRACE_TIME]))
     {
-        curr = list;
-        list = list->next;
-        free(curr->memory_address);
-        free(curr);
+        uint64_t n = arrivals->n_processes;
+
+        if (n == arrivals->capacity)
+        {
+            //Binary traces know their length up front
+            if (n == 0 && parser->trace)
+            {
+                arrivals->capacity = parser->trace->n_processes;
+            }
+            else
+            {
+                arrivals->capacity = n ? n * 2 : INIT_ARRIVALS_CAPACITY;
+            }
+
+            for (int c = 0; c < N_TRACE_COLUMNS; c++)
+            {
+                arrivals->columns[c] = realloc(arrivals->columns[c], sizeof(uint32_t) * arrivals->capacity);
+                if (!arrivals->columns[c])
+                {
+                    fprintf(stderr, "Malloc failed!\n");
+                    exit(1);
+                }
+            }
+        }
+
+        for (int c = 0; c < N_TRACE_COLUMNS; c++)
+        {
+            arrivals->columns[c][n] = values[c];
+        }
+        arrivals->n_processes += 1;
+    }
+
+    close_parser(parser);
+    return arrivals;
+}
+
+/*
+Frees up arrivals read by read_all_arrivals()
+@params
+arrivals, struct arrivals_t *, the arrivals
+*/
+void free_arrivals(struct arrivals_t *arrivals)
+{
+    for (int c = 0; c < N_TRACE_COLUMNS; c++)
+    {
+        free(arrivals->columns[c]);
     }
+    free(arrivals);
 }
 
 /*
-Counts the number of processes in a linked list
+Opens a workload that reads processes from the input file lazily, one at a time
+!! CLOSES THE FILE WHEN THE WORKLOAD IS CLOSED
 @params
-list, struct process_t *, the linked list
+fptr, FILE *, the input file, NULL for a workload with no file
 
 @return
-uint32_t, number of processes in linked list
+struct workload_t *, the opened workload
 */
-uint32_t count_processes(struct process_t *list)
+struct workload_t *open_workload(FILE *fptr)
 {
-    struct process_t *curr = list;
-    uint32_t n = 1;
+    struct workload_t *workload = malloc(sizeof(struct workload_t));
 
-    //Returns 0 for empty list and 1 for singleton list
-    if (!list)
+    if (!workload)
     {
-        return 0;
+        fprintf(stderr, "Malloc failed!\n");
+        exit(1);
     }
-    else if (list->next == NULL)
+
+    workload->parser = fptr ? open_parser(fptr) : NULL;
+    workload->arrivals = NULL;
+    workload->next_arrival = 0;
+
+    //Binary traces know their length up front
+    if (workload->parser && workload->parser->trace)
     {
-        return n;
+        workload->pool = init_process_pool(workload->parser->trace->n_processes);
     }
-
-    while(curr->next != NULL)
+    else
     {
-        n += 1;
-        curr = curr->next;
+        workload->pool = init_process_pool(0);
     }
-    return n;
+
+    return workload;
 }
 
 /*
-Translates all process entries in the input file into process_t linked lists
-!! FOR USE IN POPPING PROCESSES WHEN CPU CLOCK CORRESPONDS TO ARRIVAL TIME
-!! WHEN RUNNING SIMULATION
+Opens a workload that reads processes from arrivals already read from the input file
+!! ONLY READS THE GIVEN ARRIVALS, SAFE TO SHARE THEM BETWEEN THREADS
 @params
-fptr, FILE *, the input file
+arrivals, const struct arrivals_t *, the arrivals, in order of the input file
 
 @return
-head struct pointer of type struct process_t * for linked list
+struct workload_t *, the opened workload
 */
-struct process_t *get_all_processes(FILE *fptr)
+struct workload_t *open_shared_workload(const struct arrivals_t *arrivals)
 {
-    struct process_t *head = malloc(sizeof(struct process_t));
-    struct process_t *curr = NULL;
-    struct process_t *new_process = NULL;
-    uint32_t time = 0, pid = 0, mem = 0, time_fin = 0, is_head = 1;
+    struct workload_t *workload = open_workload(NULL);
 
-    while (fscanf(fptr, "%"SCNd32" %"SCNd32" %"SCNd32" %"SCNd32" ", &time, &pid, &mem, &time_fin) == 4)
+    workload->arrivals = arrivals;
+
+    return workload;
+}
+
+/*
+Reads the next process of a workload, in the order of the input file
+@params
+workload, struct workload_t *, the workload
+
+@return
+struct process_t *, the next process, NULL if there are no more processes
+*/
+struct process_t *read_process(struct workload_t *workload)
+{
+    const struct arrivals_t *arrivals = workload->arrivals;
+    uint32_t time = 0, pid = 0, mem = 0, time_fin = 0;
+    uint64_t i = workload->next_arrival;
+
+    if (arrivals)
     {
-        //Add first element into head
-        if (is_head)
+        if (i == arrivals->n_processes)
         {
-            new_process = create_process(pid, time, mem, time_fin);
-            head = new_process;
-            curr = head;
-            is_head = 0;
-            continue;
-        }   
-        
-        //Iterate to end of list
-        while (curr->next != NULL)
-        {
-            curr = curr->next;
+            return NULL;
         }
-        
-        //Append new process to end
-        new_process = create_process(pid, time, mem, time_fin);
-        curr->next = new_process;
+        workload->next_arrival += 1;
+
+        return create_process(workload->pool, arrivals->columns[TRACE_PID][i],
+         arrivals->columns[TRACE_ARRIVAL][i], arrivals->columns[TRACE_MEMORY][i], arrivals->columns[TRACE_TIME][i]);
     }
 
-    fclose(fptr);
-    return head;
+    if (!workload->parser)
+    {
+        return NULL;
+    }
+
+    if (parse_process_line(workload->parser, &time, &pid, &mem, &time_fin))
+    {
+        return create_process(workload->pool, pid, time, mem, time_fin);
+    }
+
+    return NULL;
+}
+
+/*
+Gives a process that has left the simulation back to its workload
+@params
+workload, struct workload_t *, the workload the process was read from
+process, struct process_t *, the process
+*/
+void release_process(struct workload_t *workload, struct process_t *process)
+{
+    pool_release(workload->pool, process);
+}
+
+/*
+Closes a workload, freeing every process read from it at once, whether or not it has
+been released
+@params
+workload, struct workload_t *, the workload
+*/
+void close_workload(struct workload_t *workload)
+{
+    if (workload->parser)
+    {
+        close_parser(workload->parser);
+    }
+    free_process_pool(workload->pool);
+    free(workload);
 }
 
 /*
@@ -173,137 +268,72 @@ int has_process_arrived(uint32_t cpu_clock, struct process_t *master)
 }
 
 /*
-Shuffles the process list as per Round-Robin scheduling
+Shuffles the run queue as per Round-Robin scheduling, the head moves to the tail
 @params
-list, struct process_t *, linked list of processes 
-
-@return
-struct process_t *, the new linked list after round robin
+queue, struct run_queue_t *, the run queue
+memory, struct memory_t **, pointer to the memory_t * to allow modification
 */
-struct process_t *round_robin_shuffle(struct process_t *list, struct memory_t **memory)
+void round_robin_shuffle(struct run_queue_t *queue, struct memory_t **memory)
 {
-    uint32_t pid1 = 0, pid_count = 0;
-    struct process_t *new_head = NULL;
-    struct process_t *temp = NULL;
-    struct process_t *end = list;
-
-    //Returns if empty list
-    if(!list)
-    {
-        return NULL;
-    }
-
-    //Case for singleton list
-    if (list->next == NULL)
-    {
-        return list;
-    }
-
-    //Store 2nd element as the new head
-    new_head = list->next;
-    temp = new_head;
-    
-    //Iterate to the end of linked list
-    while (temp->next != NULL)
-    {
-        temp = temp->next;
-    }
+    struct process_t *end = queue->head;
 
-    //Insert old list head at the end of list
-    temp->next = end;
-    temp->next->next = NULL;
-
-    while((*memory)->pid_loaded[pid_count] != UINT32_MAX)
-    {
-        pid_count += 1;
-    }
-
-    //if empty or singleton, dont shuffle
-    if(pid_count <= 1)
-    {
-        return new_head;
-    }
-    
-    pid1 = (*memory)->pid_loaded[0];
-    //Insert first element into last
-    for (uint32_t i = 0; i < (*memory)->n_total_pages - 1; i++)
+    //Returns if empty or singleton run queue
+    if (queue->length <= 1)
     {
-        //found last element
-        if ((*memory)->pid_loaded[i] == UINT32_MAX)
-        {
-            (*memory)->pid_loaded[i-1] = pid1;
-            break;
-        }
-        
-        (*memory)->pid_loaded[i] = (*memory)->pid_loaded[i+1];
+        return;
     }
 
-    return new_head;
+    //Insert old head at the end of the run queue
+    queue->head = end->next;
+    queue->head->prev = NULL;
+    queue->tail->next = end;
+    end->prev = queue->tail;
+    end->next = NULL;
+    queue->tail = end;
+    queue->batch_prev = NULL;
+
+    //Loaded processes follow the same order
+    rotate_loaded(memory);
 }
 
 /*
 place process with shortest job times at the first index of running process queue
+!! TIES GO TO THE EARLIEST ARRIVAL, THEN SMALLEST PID, OTHER THAN THE HEAD WHICH ONLY
+!! KEEPS RUNNING FIRST IF NO OTHER PROCESS HAS ITS JOB TIME
 @params
-list, struct process_t *, the running process list
-
-@return
-struct process_t *, the modified list
+queue, struct run_queue_t *, the running process queue, with a job heap
 */
-struct process_t *sort_shortest_job(struct process_t *list)
+void sort_shortest_job(struct run_queue_t *queue)
 {
-    struct process_t *curr = list;
-    uint32_t small_job = UINT32_MAX;
-    struct process_t *new_list = NULL;
+    struct process_t *head = queue->head;
+    struct process_t *shortest = job_heap_peek(queue->heap);
 
-    //For empty list
-    if (!list)
+    //For empty or singleton run queue, or if the head is strictly the shortest
+    if (!shortest || shortest->job_time > head->job_time)
     {
-        return NULL;
-    }
-    //For singleton list
-    if(list->next == NULL)
-    {
-        return list;
+        return;
     }
 
-    //find the shortest job time from process list
-    while (curr != NULL)
+    //Unlink shortest job from the run queue
+    shortest->prev->next = shortest->next;
+    if (shortest->next)
     {
-        if (curr->job_time < small_job)
-        {
-            small_job = curr->job_time;
-        }
-        curr = curr->next;
+        shortest->next->prev = shortest->prev;
     }
-    curr = list;
-
-    //puts shortest job at the head
-    while (curr->next != NULL)
+    else
     {
-        if (curr->next->job_time == small_job)
-        {
-            if (curr->next->next == NULL)
-            {
-                new_list = curr->next;
-                new_list->next = list;
-                curr->next = NULL;
-                break;
-            }
-            else
-            {
-                struct process_t *temp = NULL;
-
-                new_list = curr->next;
-                temp = curr->next->next;
-                new_list->next = list;
-                curr->next = temp;
-                break;
-            }
-        }
-        curr = curr->next;
+        queue->tail = shortest->prev;
     }
 
-    return new_list;
+    //Puts shortest job at the head, the old head is now indexed in its place
+    shortest->prev = NULL;
+    shortest->next = head;
+    head->prev = shortest;
+    queue->head = shortest;
+    queue->batch_prev = NULL;
+
+    job_heap_remove(queue->heap, shortest);
+    job_heap_insert(queue->heap, head);
 }
 
 /*
@@ -333,6 +363,34 @@ int execute_process(uint32_t cpu_clock, struct process_t **list)
     return 0;
 }
 
+/*
+Runs the head process for a number of consecutive ticks in which no scheduling
+event occurs. Loading penalty is consumed first, the rest goes to the job itself.
+!! ASSUMES THE PROCESS DOES NOT FINISH WITHIN THE GIVEN TICKS
+@params
+cpu_clock, uint32_t, representation of CPU clock in Seconds, at the first tick
+ticks, uint32_t, number of ticks to run the process for
+list, struct process_t **, pointer to the process_t linked list
+
+@return
+uint32_t, number of ticks spent executing the job after its loading penalty
+*/
+uint32_t execute_process_ticks(uint32_t cpu_clock, uint32_t ticks, struct process_t **list)
+{
+    uint32_t penalty_ticks = ticks;
+
+    if ((*list)->time_load_penalty < penalty_ticks)
+    {
+        penalty_ticks = (*list)->time_load_penalty;
+    }
+
+    (*list)->time_last_used = cpu_clock + ticks - 1;
+    (*list)->time_load_penalty -= penalty_ticks;
+    (*list)->time_required -= ticks - penalty_ticks;
+
+    return ticks - penalty_ticks;
+}
+
 /*
 Pops the first element from the linked list provided
 @params
@@ -360,99 +418,161 @@ struct process_t *list_pop(struct process_t **list)
 }
 
 /*
-Appends a process to the end of a linked list
-!! Appends before end of list if multiple processes with same arrival time
+Initialises an empty run queue
+@params
+queue, struct run_queue_t *, the run queue
+job_heap, int, 1 to index the run queue on shortest job, for sort_shortest_job
+*/
+void init_run_queue(struct run_queue_t *queue, int job_heap)
+{
+    queue->head = NULL;
+    queue->tail = NULL;
+    queue->batch_prev = NULL;
+    queue->length = 0;
+    queue->heap = job_heap ? init_job_heap() : NULL;
+}
+
+/*
+Frees a run queue's index, the processes left in it belong to their workload
+@params
+queue, struct run_queue_t *, the run queue
+*/
+void free_run_queue(struct run_queue_t *queue)
+{
+    if (queue->heap)
+    {
+        free_job_heap(queue->heap);
+    }
+    init_run_queue(queue, 0);
+}
+
+/*
+Appends a process to the end of the run queue
+!! Appends before end of queue if multiple processes with same arrival time
 !! (sorts on ascending pid order)
+!! Only the processes of the latest arrival batch are walked, which is every process
+!! with the same arrival time as the workload arrives in order
 @params
-list, struct process_t *, the linked list to append to
+queue, struct run_queue_t *, the run queue to append to
 item, struct process_t *, the process to append
 */
-struct process_t *list_push(struct process_t *list, struct process_t *item)
+void queue_push(struct run_queue_t *queue, struct process_t *item)
 {
-    struct process_t *temp = malloc(sizeof(struct process_t));
-    struct process_t *curr = list;
-    
-    temp = item;
-    
+    struct process_t *curr = queue->head;
+
+    item->next = NULL;
+    item->prev = NULL;
+    queue->length += 1;
+
+    //A batch arriving at an empty run queue starts at the head, which is never compared
+    //against, so walking from it is the same as walking from the head
+    if (!curr)
+    {
+        queue->head = item;
+        queue->tail = item;
+        queue->batch_prev = item;
+        return;
+    }
+
+    //Every process but the head is indexed, whichever of the two is not the head now
+    if (queue->heap)
+    {
+        job_heap_insert(queue->heap, item);
+    }
+
     //Inserts in ascending order of pid if more than 1 process arrived at 
     //the same time. Compares arrival time of an element already in the 
-    //linked list and its subsequent process' pid (For case of 1 element)
-    if (temp->arrival_time == curr->arrival_time && curr->next == NULL)
+    //run queue and its subsequent process' pid (For case of 1 element)
+    if (item->arrival_time == curr->arrival_time && curr->next == NULL)
     {
-        if (temp->pid < curr->pid)
+        if (item->pid < curr->pid)
         {
-            temp->next = curr;
-            return temp;
+            item->next = curr;
+            curr->prev = item;
+            queue->head = item;
+            queue->batch_prev = item;
+
+            if (queue->heap)
+            {
+                job_heap_remove(queue->heap, item);
+                job_heap_insert(queue->heap, curr);
+            }
+            return;
         }
     }
-    
-    while (curr->next != NULL)
+
+    //First process of a new arrival batch goes to the end
+    if (item->arrival_time != queue->tail->arrival_time)
     {
-        //Inserts in ascending order of pid if more than 1 process arrived at 
-        //the same time. Compares arrival time of an element already in the 
-        //linked list and its subsequent process' pid
-        if (temp->arrival_time == curr->next->arrival_time && curr->next->pid > temp->pid)
+        queue->batch_prev = queue->tail;
+        curr = queue->tail;
+    }
+    //The batch is kept in ascending pid order, no larger pid in it if the tail is not larger
+    else if (queue->batch_prev && queue->tail->pid <= item->pid)
+    {
+        curr = queue->tail;
+    }
+    else
+    {
+        //Head is never compared against, other than as the only element
+        if (queue->batch_prev)
         {
-            struct process_t *node = NULL;
-            node = curr->next;
-
-            curr->next = temp;
-            temp-> next = node;
+            curr = queue->batch_prev;
+        }
 
-            return list;
+        while (curr->next != NULL)
+        {
+            //Inserts in ascending order of pid if more than 1 process arrived at 
+            //the same time. Compares arrival time of an element already in the 
+            //run queue and its subsequent process' pid
+            if (item->arrival_time == curr->next->arrival_time && curr->next->pid > item->pid)
+            {
+                item->next = curr->next;
+                item->prev = curr;
+                curr->next->prev = item;
+                curr->next = item;
+                return;
+            }
+            curr = curr->next;
         }
-        curr = curr->next;
     }
     
-    curr->next = temp;
-
-    return list;
+    curr->next = item;
+    item->prev = curr;
+    queue->tail = item;
 }
 
 /*
-Removes a particular element from the list, if any
+Pops the head of the run queue
 @params
-list, struct process_t *, the linked list
-process, struct process_t *, the element to remove
+queue, struct run_queue_t *, the run queue
 
 @return
-struct process_t *, the (un)modified linked list
+struct process_t *, the popped process, NULL if the run queue is empty
 */
-struct process_t *list_remove(struct process_t *list, struct process_t *process)
+struct process_t *queue_pop(struct run_queue_t *queue)
 {
-    struct process_t *curr = list;
+    struct process_t *head = list_pop(&queue->head);
 
-    //Check is the first element in the singleton list, the element in question
-    if (curr->pid == process->pid)
+    if (!head)
     {
-        struct process_t *junk;
-
-        junk = list_pop(&curr);
-        curr = junk->next;
-        free(junk);
-        return curr;
+        return NULL;
     }
 
-    while (curr->next != NULL)
+    queue->length -= 1;
+    queue->batch_prev = NULL;
+    if (!queue->head)
     {
-        if (curr->next->pid == process->pid)
-        {
-            struct process_t *junk = curr->next;
-
-            if (curr->next->next != NULL)
-            {
-                curr->next = curr->next->next;
-            }
-            else
-            {
-                curr->next = NULL;
-            }
-            free(junk);
-            return list;
-        }    
+        queue->tail = NULL;
+        return head;
+    }
 
-        curr = curr->next;
+    //New head is no longer indexed
+    queue->head->prev = NULL;
+    if (queue->heap)
+    {
+        job_heap_remove(queue->heap, queue->head);
     }
 
-    return list;
+    return head;
 }
\ No newline at end of file
@@ -0,0 +1,365 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "../include/resident_set.h"
+
+//Constants
+#define INIT_TABLE_CAPACITY 64
+#define INIT_SET_CAPACITY 4
+#define NO_PID UINT32_MAX
+
+//Functions
+uint32_t hash_pid(struct resident_table_t *, uint32_t);
+uint32_t find_slot(struct resident_table_t *, uint32_t);
+void grow_table(struct resident_table_t *);
+void drop_set(struct resident_table_t *, uint32_t);
+void link_tail(struct resident_table_t *, struct resident_set_t *);
+void unlink_set(struct resident_table_t *, struct resident_set_t *);
+
+/*
+Creates an empty resident table
+@params
+n_pages, uint32_t, number of page frames in main memory
+
+@return
+struct resident_table_t *, the table
+*/
+struct resident_table_t *init_resident_table(uint32_t n_pages)
+{
+    struct resident_table_t *table = malloc(sizeof(struct resident_table_t));
+
+    if (!table)
+    {
+        fprintf(stderr, "Malloc failed!\n");
+        exit(1);
+    }
+
+    table->capacity = INIT_TABLE_CAPACITY;
+    table->n_sets = 0;
+    table->lru_head = NO_PID;
+    table->lru_tail = NO_PID;
+    table->sets = malloc(sizeof(struct resident_set_t) * table->capacity);
+    table->frame_index = malloc(sizeof(uint32_t) * (n_pages ? n_pages : 1));
+
+    if (!table->sets || !table->frame_index)
+    {
+        fprintf(stderr, "Malloc failed!\n");
+        exit(1);
+    }
+
+    for (uint32_t i = 0; i < table->capacity; i++)
+    {
+        table->sets[i].pid = NO_PID;
+    }
+
+    return table;
+}
+
+/*
+Hashes a pid to its home slot, by Fibonacci hashing
+!! ASSUMES CAPACITY IS A POWER OF 2
+@params
+table, struct resident_table_t *, the table
+pid, uint32_t, the Process ID
+
+@return
+uint32_t, the home slot
+*/
+uint32_t hash_pid(struct resident_table_t *table, uint32_t pid)
+{
+    return (uint32_t) (pid * UINT32_C(2654435761)) & (table->capacity - 1);
+}
+
+/*
+Finds the slot holding the set of a pid, or the empty slot it would go into
+@params
+table, struct resident_table_t *, the table
+pid, uint32_t, the Process ID
+
+@return
+uint32_t, the slot
+*/
+uint32_t find_slot(struct resident_table_t *table, uint32_t pid)
+{
+    uint32_t i = hash_pid(table, pid);
+
+    while (table->sets[i].pid != NO_PID && table->sets[i].pid != pid)
+    {
+        i = (i + 1) & (table->capacity - 1);
+    }
+
+    return i;
+}
+
+/*
+Finds the resident set of a process
+@params
+table, struct resident_table_t *, the table
+pid, uint32_t, the Process ID
+
+@return
+struct resident_set_t *, the set, NULL if the process has no frames
+*/
+struct resident_set_t *find_resident_set(struct resident_table_t *table, uint32_t pid)
+{
+    uint32_t i = 0;
+
+    if (pid == NO_PID)
+    {
+        return NULL;
+    }
+
+    i = find_slot(table, pid);
+
+    return table->sets[i].pid == pid ? &table->sets[i] : NULL;
+}
+
+/*
+Counts the frames held by a process
+@params
+table, struct resident_table_t *, the table
+pid, uint32_t, the Process ID
+
+@return
+uint32_t, number of frames
+*/
+uint32_t count_resident(struct resident_table_t *table, uint32_t pid)
+{
+    struct resident_set_t *set = find_resident_set(table, pid);
+
+    return set ? set->n_frames : 0;
+}
+
+/*
+Doubles the table, rehashing every set
+@params
+table, struct resident_table_t *, the table
+*/
+void grow_table(struct resident_table_t *table)
+{
+    struct resident_set_t *old = table->sets;
+    uint32_t old_capacity = table->capacity;
+
+    table->capacity *= 2;
+    table->sets = malloc(sizeof(struct resident_set_t) * table->capacity);
+
+    if (!table->sets)
+    {
+        fprintf(stderr, "Malloc failed!\n");
+        exit(1);
+    }
+
+    for (uint32_t i = 0; i < table->capacity; i++)
+    {
+        table->sets[i].pid = NO_PID;
+    }
+    for (uint32_t i = 0; i < old_capacity; i++)
+    {
+        if (old[i].pid != NO_PID)
+        {
+            table->sets[find_slot(table, old[i].pid)] = old[i];
+        }
+    }
+
+    free(old);
+}
+
+/*
+Adds a frame to the resident set of a process, creating the set if needed
+!! ASSUMES FRAME IS NOT IN ANY SET
+@params
+table, struct resident_table_t *, the table
+pid, uint32_t, the Process ID
+frame, uint32_t, index of the page frame
+*/
+void resident_add(struct resident_table_t *table, uint32_t pid, uint32_t frame)
+{
+    struct resident_set_t *set = NULL;
+    uint32_t i = 0;
+
+    //Keeps load below 3/4 so probe runs stay short
+    if ((table->n_sets + 1) * 4 > table->capacity * 3)
+    {
+        grow_table(table);
+    }
+
+    i = find_slot(table, pid);
+    set = &table->sets[i];
+
+    if (set->pid == NO_PID)
+    {
+        set->pid = pid;
+        set->n_frames = 0;
+        set->capacity = INIT_SET_CAPACITY;
+        set->frames = malloc(sizeof(uint32_t) * set->capacity);
+        table->n_sets += 1;
+        link_tail(table, set);
+    }
+    else if (set->n_frames == set->capacity)
+    {
+        set->capacity *= 2;
+        set->frames = realloc(set->frames, sizeof(uint32_t) * set->capacity);
+    }
+
+    if (!set->frames)
+    {
+        fprintf(stderr, "Malloc failed!\n");
+        exit(1);
+    }
+
+    table->frame_index[frame] = set->n_frames;
+    set->frames[set->n_frames] = frame;
+    set->n_frames += 1;
+}
+
+/*
+Removes a frame from the resident set of a process, dropping the set once empty
+!! ASSUMES FRAME IS IN THE SET OF PID
+@params
+table, struct resident_table_t *, the table
+pid, uint32_t, the Process ID
+frame, uint32_t, index of the page frame
+*/
+void resident_remove(struct resident_table_t *table, uint32_t pid, uint32_t frame)
+{
+    uint32_t i = find_slot(table, pid);
+    struct resident_set_t *set = &table->sets[i];
+    uint32_t at = table->frame_index[frame];
+    uint32_t last = set->frames[set->n_frames - 1];
+
+    //Last frame fills the gap
+    set->frames[at] = last;
+    table->frame_index[last] = at;
+    set->n_frames -= 1;
+
+    if (set->n_frames == 0)
+    {
+        drop_set(table, i);
+    }
+}
+
+/*
+Empties a slot of the table, shifting back later sets of the probe run so lookups
+never stop early
+@params
+table, struct resident_table_t *, the table
+i, uint32_t, the slot
+*/
+void drop_set(struct resident_table_t *table, uint32_t i)
+{
+    uint32_t mask = table->capacity - 1;
+    uint32_t j = i, home = 0;
+
+    unlink_set(table, &table->sets[i]);
+    free(table->sets[i].frames);
+    table->n_sets -= 1;
+
+    while (1)
+    {
+        j = (j + 1) & mask;
+        if (table->sets[j].pid == NO_PID)
+        {
+            break;
+        }
+
+        home = hash_pid(table, table->sets[j].pid);
+        //Moves the set back if the gap lies between its home slot and where it sits
+        if (((j - home) & mask) >= ((j - i) & mask))
+        {
+            table->sets[i] = table->sets[j];
+            i = j;
+        }
+    }
+
+    table->sets[i].pid = NO_PID;
+}
+
+/*
+Links a set in as the most recently loaded
+@params
+table, struct resident_table_t *, the table
+set, struct resident_set_t *, the set, not linked yet
+*/
+void link_tail(struct resident_table_t *table, struct resident_set_t *set)
+{
+    set->lru_prev = table->lru_tail;
+    set->lru_next = NO_PID;
+
+    if (table->lru_tail == NO_PID)
+    {
+        table->lru_head = set->pid;
+    }
+    else
+    {
+        find_resident_set(table, table->lru_tail)->lru_next = set->pid;
+    }
+    table->lru_tail = set->pid;
+}
+
+/*
+Unlinks a set from the loaded order
+@params
+table, struct resident_table_t *, the table
+set, struct resident_set_t *, the set
+*/
+void unlink_set(struct resident_table_t *table, struct resident_set_t *set)
+{
+    if (set->lru_prev == NO_PID)
+    {
+        table->lru_head = set->lru_next;
+    }
+    else
+    {
+        find_resident_set(table, set->lru_prev)->lru_next = set->lru_next;
+    }
+
+    if (set->lru_next == NO_PID)
+    {
+        table->lru_tail = set->lru_prev;
+    }
+    else
+    {
+        find_resident_set(table, set->lru_next)->lru_prev = set->lru_prev;
+    }
+}
+
+/*
+Moves the earliest loaded process behind the most recently loaded one, as the run
+queue does under Round-Robin
+@params
+table, struct resident_table_t *, the table
+*/
+void rotate_resident(struct resident_table_t *table)
+{
+    struct resident_set_t *head = NULL;
+
+    //Empty or singleton
+    if (table->lru_head == table->lru_tail)
+    {
+        return;
+    }
+
+    head = find_resident_set(table, table->lru_head);
+    unlink_set(table, head);
+    link_tail(table, head);
+}
+
+/*
+Frees the table and every set in it
+@params
+table, struct resident_table_t *, the table
+*/
+void free_resident_table(struct resident_table_t *table)
+{
+    for (uint32_t i = 0; i < table->capacity; i++)
+    {
+        if (table->sets[i].pid != NO_PID)
+        {
+            free(table->sets[i].frames);
+        }
+    }
+
+    free(table->sets);
+    free(table->frame_index);
+    free(table);
+}
@@ -0,0 +1,165 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <sched.h>
+#include <time.h>
+#include "../include/ring.h"
+
+//Constants
+#define N_SPINS_BEFORE_SLEEP 64
+#define RING_SLEEP_NS 20000
+
+//Functions
+void ring_wait(int *);
+
+/*
+Creates an empty ring
+@params
+capacity_log2, uint32_t, the ring holds 2^capacity_log2 words
+
+@return
+struct ring_t *, the ring
+*/
+struct ring_t *init_ring(uint32_t capacity_log2)
+{
+    struct ring_t *ring = NULL;
+
+    if (posix_memalign((void **)&ring, SIZE_CACHE_LINE, sizeof(struct ring_t)) != 0)
+    {
+        fprintf(stderr, "Malloc failed!\n");
+        exit(1);
+    }
+
+    memset(ring, 0, sizeof(struct ring_t));
+    ring->mask = ((uint64_t)1 << capacity_log2) - 1;
+    ring->words = malloc(sizeof(uint32_t) * (ring->mask + 1));
+
+    if (!ring->words)
+    {
+        fprintf(stderr, "Malloc failed!\n");
+        exit(1);
+    }
+
+    return ring;
+}
+
+/*
+Pushes words into the ring, a record longer than the ring goes through in pieces
+!! PRODUCER ONLY, ONLY WAITS WHILE THE RING IS FULL
+@params
+ring, struct ring_t *, the ring
+words, const uint32_t *, the words to push
+n, size_t, the number of words
+*/
+void ring_push(struct ring_t *ring, const uint32_t *words, size_t n)
+{
+    uint64_t head = ring->head;
+    int n_waits = 0;
+
+    while (n > 0)
+    {
+        uint64_t tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+        uint64_t n_free = ring->mask + 1 - (head - tail);
+
+        if (n_free == 0)
+        {
+            ring_wait(&n_waits);
+            continue;
+        }
+        n_waits = 0;
+
+        for (; n_free > 0 && n > 0; n_free--, n--)
+        {
+            ring->words[head & ring->mask] = *words++;
+            head += 1;
+        }
+        __atomic_store_n(&ring->head, head, __ATOMIC_RELEASE);
+    }
+}
+
+/*
+Pops words from the ring, waiting until all of them have been pushed
+!! CONSUMER ONLY
+@params
+ring, struct ring_t *, the ring
+words, uint32_t *, stores the popped words
+n, size_t, the number of words
+
+@return
+size_t, the number of words popped, fewer than n only once the ring is closed and empty
+*/
+size_t ring_pop(struct ring_t *ring, uint32_t *words, size_t n)
+{
+    uint64_t tail = ring->tail;
+    size_t n_popped = 0;
+    int n_waits = 0;
+
+    while (n_popped < n)
+    {
+        uint64_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+
+        if (head == tail)
+        {
+            //Closing happens after the last push, so check for words once more
+            if (__atomic_load_n(&ring->closed, __ATOMIC_ACQUIRE))
+            {
+                if (__atomic_load_n(&ring->head, __ATOMIC_ACQUIRE) == tail)
+                {
+                    break;
+                }
+                continue;
+            }
+            ring_wait(&n_waits);
+            continue;
+        }
+        n_waits = 0;
+
+        for (; tail != head && n_popped < n; tail++)
+        {
+            words[n_popped++] = ring->words[tail & ring->mask];
+        }
+        __atomic_store_n(&ring->tail, tail, __ATOMIC_RELEASE);
+    }
+
+    return n_popped;
+}
+
+/*
+Backs off while the other side of the ring catches up, spinning briefly before sleeping
+@params
+n_waits, int *, the number of consecutive waits so far
+*/
+void ring_wait(int *n_waits)
+{
+    struct timespec delay = {0, RING_SLEEP_NS};
+
+    if ((*n_waits)++ < N_SPINS_BEFORE_SLEEP)
+    {
+        sched_yield();
+        return;
+    }
+    nanosleep(&delay, NULL);
+}
+
+/*
+Marks the end of the producer's records, the consumer drains what is left
+!! PRODUCER ONLY
+@params
+ring, struct ring_t *, the ring
+*/
+void close_ring(struct ring_t *ring)
+{
+    __atomic_store_n(&ring->closed, 1, __ATOMIC_RELEASE);
+}
+
+/*
+Frees a ring
+@params
+ring, struct ring_t *, the ring
+*/
+void free_ring(struct ring_t *ring)
+{
+    free(ring->words);
+    free(ring);
+}
@@ -0,0 +1,14 @@
+#include <stdint.h>
+#include "../include/policy.h"
+
+/*
+Custom scheduling, Shortest-Job-First, runs the waiting process with the shortest job time
+to completion
+*/
+struct sched_policy_t sched_shortest_job = {
+    .name = "cs",
+    .job_heap = 1,
+    .on_arrival = queue_push,
+    .pick_next = sort_shortest_job,
+    .on_quantum_expiry = NULL,
+};
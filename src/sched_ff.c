@@ -0,0 +1,13 @@
+#include <stdint.h>
+#include "../include/policy.h"
+
+/*
+First-come first-served scheduling, runs each process to completion in order of arrival
+*/
+struct sched_policy_t sched_first_come = {
+    .name = "ff",
+    .job_heap = 0,
+    .on_arrival = queue_push,
+    .pick_next = keep_run_order,
+    .on_quantum_expiry = NULL,
+};
@@ -0,0 +1,13 @@
+#include <stdint.h>
+#include "../include/policy.h"
+
+/*
+Round-Robin scheduling, moves the running process to the back of the run queue every quantum
+*/
+struct sched_policy_t sched_round_robin = {
+    .name = "rr",
+    .job_heap = 0,
+    .on_arrival = queue_push,
+    .pick_next = keep_run_order,
+    .on_quantum_expiry = round_robin_shuffle,
+};
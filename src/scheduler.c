@@ -2,9 +2,15 @@
 #include <string.h>
 #include <stdlib.h>
 #include <stdint.h>
+#include <unistd.h>
 #include "../include/utilities.h"
 #include "../include/process_scheduling.h"
 #include "../include/memory.h"
+#include "../include/simulation.h"
+#include "../include/policy.h"
+#include "../include/sweep.h"
+#include "../include/trace.h"
+#include "../include/writer.h"
 
 //Constants
 #define PARAM_FILE "-f"
@@ -12,80 +18,130 @@
 #define PARAM_MEMALLOC "-m"
 #define PARAM_MEMSIZE "-s"
 #define PARAM_QUANTUM "-q"
-#define ALGO_ROUNDROBIN "rr"
-#define ALGO_FCOME_FSERVED "ff"
-#define ALGO_CUSTOM "cs"
-#define MEM_SWAPPING_X "p"
-#define MEM_UNLIMITED "u"
-#define MEM_VIRTUAL_MEM "v"
-#define MEM_CUSTOM "cm"
+#define PARAM_SWEEP "--sweep"
+#define PARAM_THREADS "-j"
+#define PARAM_QUIET "--quiet"
+#define PARAM_ASYNC "--async"
+#define PARAM_EVICTIONS "--evictions"
+#define PARAM_FORMAT "--format"
+#define CMD_CONVERT "convert"
 
 #define SIZE_INPUTFILE 1000
-#define SIZE_ALGO 3
-#define SIZE_MEMALLOC 4
-#define SIZE_BUFFER 256
-#define SIZE_PROCESSES 100
-#define SIZE_PER_MEM_PAGE 4
-
-void run_memory(struct memory_t **memory, char *mem_alloc, struct process_t *list, uint32_t cpu_clock);
 
 int main(int argc, char **argv) 
 {
     char input_file[SIZE_INPUTFILE];
-    char sched_algo[SIZE_ALGO];
-    char *mem_alloc = NULL;
-    uint32_t mem_size = 0;
-    int quantum = 0, quantum_clock = 0, fin_flag = 0;
+    char *algo_arg = ALGO_FCOME_FSERVED, *mem_arg = MEM_UNLIMITED, *size_arg = "0", *quantum_arg = "0";
+    char *sweep_file = NULL;
+    int n_threads = 0;
+    int quiet = 0;
+    int async = 0;
+    int evictions = 0;
+    int format = FORMAT_TEXT;
     FILE *file;
-    
-    struct datalog_t *log = NULL;
-    struct process_t *curr_process_list = NULL;
-    struct process_t *incoming_processes = malloc(sizeof(struct process_t));
-    struct memory_t *memory = NULL;
-    uint32_t *evicted_mem = NULL;
-    uint32_t cpu_clock = 0;
 
-    log = init_datalog();
-    sched_algo[0] = '\0';
-    mem_alloc = malloc(sizeof(char) * SIZE_MEMALLOC);
+    struct sim_config_t config;
+    struct sim_t *sim = NULL;
+    struct perf_stats_t stats;
+
+    input_file[0] = '\0';
 
-    if (!mem_alloc)
+    //Converts a text trace into a binary trace, as: convert <text trace> <binary trace>
+    if (argc > 1 && strcmp(argv[1], CMD_CONVERT) == 0)
     {
-        fprintf(stderr, "Malloc failed!\n");
-        exit(1);
+        FILE *out = NULL;
+
+        if (argc != 4)
+        {
+            fprintf(stderr, "Usage: %s %s <text trace> <binary trace>\n", argv[0], CMD_CONVERT);
+            exit(1);
+        }
+        if ((file = fopen(argv[2], "r")) == NULL)
+        {
+            fprintf(stderr, "Unable to open file!\n");
+            exit(1);
+        }
+        if ((out = fopen(argv[3], "w+")) == NULL)
+        {
+            fprintf(stderr, "Unable to open binary trace output file!\n");
+            exit(1);
+        }
+
+        convert_trace(file, out);
+
+        return 0;
     }
 
     //Read input and params from CL arguments
     for (int i=1; i < argc; i++) 
     {
+        //Checks if CL param is quiet mode, a param without a value
+        if (strcmp(argv[i], PARAM_QUIET) == 0)
+        {
+            quiet = 1;
+            continue;
+        }
+        //Checks if CL param is to format and write the transcript on its own thread
+        else if (strcmp(argv[i], PARAM_ASYNC) == 0)
+        {
+            async = 1;
+            continue;
+        }
+        //Checks if CL param is to print the pages evicted after the statistics
+        else if (strcmp(argv[i], PARAM_EVICTIONS) == 0)
+        {
+            evictions = 1;
+            continue;
+        }
+        else if (i == argc - 1)
+        {
+            break;
+        }
+
         //Checks if CL param is file input
-        if (strcmp(argv[i], PARAM_FILE) == 0)
+        else if (strcmp(argv[i], PARAM_FILE) == 0)
         {
-            strncpy(input_file, argv[i+1], strlen(argv[i+1])+1);
-            input_file[strlen(argv[i+1])] = '\0';
+            strncpy(input_file, argv[i+1], SIZE_INPUTFILE - 1);
+            input_file[SIZE_INPUTFILE - 1] = '\0';
         }
         //Checks if CL param is scheduling algorithm
         else if (strcmp(argv[i], PARAM_ALGO) == 0)
         {
-            strncpy(sched_algo, argv[i+1], strlen(argv[i+1])+1);
-            sched_algo[strlen(argv[i+1])] = '\0';
+            algo_arg = argv[i+1];
         }
         //Checks if CL param is memory allocation
         else if (strcmp(argv[i], PARAM_MEMALLOC) == 0)
         {
-            strncpy(mem_alloc, argv[i+1], strlen(argv[i+1])+1);
-            mem_alloc[strlen(argv[i+1])] = '\0';
+            mem_arg = argv[i+1];
         }
         //Checks if CL param is memory size
         else if (strcmp(argv[i], PARAM_MEMSIZE) == 0)
         {
-            sscanf(argv[i+1], "%"SCNd32, &mem_size);
+            size_arg = argv[i+1];
         }
         //Checks if CL param is quantum
         else if (strcmp(argv[i], PARAM_QUANTUM) == 0)
         {
-            quantum = atoi(argv[i+1]);
-            quantum_clock = quantum;
+            quantum_arg = argv[i+1];
+        }
+        //Checks if CL param is a parameter sweep, with its CSV output file
+        else if (strcmp(argv[i], PARAM_SWEEP) == 0)
+        {
+            sweep_file = argv[i+1];
+        }
+        //Checks if CL param is number of sweep threads
+        else if (strcmp(argv[i], PARAM_THREADS) == 0)
+        {
+            n_threads = atoi(argv[i+1]);
+        }
+        //Checks if CL param is the transcript format
+        else if (strcmp(argv[i], PARAM_FORMAT) == 0)
+        {
+            if ((format = find_format(argv[i+1])) < 0)
+            {
+                fprintf(stderr, "Unknown transcript format!\n");
+                exit(1);
+            }
         }
         else
         {
@@ -93,273 +149,85 @@ int main(int argc, char **argv)
         }
     }
 
-    memory = init_memory(mem_size, SIZE_PROCESSES);
-    
     //Reads from the stated file_input
     if ((file = fopen(input_file, "r")) == NULL)
     {
         fprintf(stderr, "Unable to open file!\n");
         exit(1);
     }
-    //Init all processes into linked list for better simulation
-    incoming_processes = get_all_processes(file);
-    
-    //Start CPU simulation
-    while(1)
-    {
-        //If a process finished running from last tick, print RUNNING transcript and handle
-        //transitions
-        if (fin_flag && curr_process_list)
-        {
-            struct process_t *junk;
-            curr_process_list->time_finished = cpu_clock;
-            
-            //Handles memory eviction for finished process if not in unlimited memory mode
-            if (strcmp(mem_alloc, MEM_UNLIMITED) != 0)
-            {
-                evicted_mem = create_uint32_array(memory->n_total_pages, UINT32_MAX);
-                evicted_mem = evict_from_memory(&memory, curr_process_list->pid);      
-                print_memory_evict(cpu_clock, evicted_mem, memory->n_total_pages);
-                free(evicted_mem);          
-            }
-            print_process_finish(cpu_clock, curr_process_list);
 
-            junk = list_pop(&curr_process_list);
-            //For performance statistics
-            add_fin_process(log, junk);
-            
-            //If no more processes to run, stop simulation.
-            if (!incoming_processes && !curr_process_list)
-            {
-
-                print_performance_stats(cpu_clock, log);
-                break;
-            }          
-            
-            //Use custom scheduling if set
-            if ((strcmp(sched_algo, ALGO_CUSTOM) == 0))
-            {
-                curr_process_list = sort_shortest_job(curr_process_list);
-            }
-
-            run_memory(&memory, mem_alloc, curr_process_list, cpu_clock);
-
-             //Set reference bit if using cm
-            if (strcmp(mem_alloc, MEM_CUSTOM) == 0)
-            {
-                set_reference_bits(&memory, 1, curr_process_list->pid);
-                // print_array(memory->reference_bit, memory->n_total_pages);
-            }
-
-            fin_flag = 0; 
-            quantum_clock = quantum;   
-
-            //There are still incoming processes in simulation but no currently running processes
-            if (incoming_processes && !curr_process_list)
-            {            
-                continue;
-            }
+    //Runs every combination of the given comma separated parameters
+    if (sweep_file)
+    {
+        struct sweep_t *sweep = init_sweep(algo_arg, mem_arg, size_arg, quantum_arg);
+        struct arrivals_t *arrivals = NULL;
+        FILE *csv = NULL;
 
-            print_process_run(cpu_clock, mem_alloc, curr_process_list->time_load_penalty, memory->mem_usage,
-             memory->n_total_pages, curr_process_list);        
-        }
+        //Reads every arrival once, shared by every simulation
+        arrivals = read_all_arrivals(file);
 
-        //Run first process at time 0
-        if (cpu_clock == 0)
+        if ((csv = fopen(sweep_file, "w")) == NULL)
         {
-            curr_process_list = malloc(sizeof(struct process_t));
-            
-            if(!curr_process_list)
-            {
-                fprintf(stderr, "Malloc failed!\n");
-                exit(1);
-            }
-
-            curr_process_list = list_pop(&incoming_processes);
-            
-            //To sort pid if at time 0 has > 1 processes arriving
-            while(incoming_processes && cpu_clock == incoming_processes->arrival_time)
-            {
-                curr_process_list = list_push(curr_process_list, list_pop(&incoming_processes));              
-            }
-
-            //Use custom scheduling if set
-            if ((strcmp(sched_algo, ALGO_CUSTOM) == 0))
-            {
-                curr_process_list = sort_shortest_job(curr_process_list);
-            }
-            
-            //Loads memory and calculate loading time penalty if not in Unlimited
-            //Memory mode
-            run_memory(&memory, mem_alloc, curr_process_list, cpu_clock);
-
-            //Set reference bit if using cm
-            if (strcmp(mem_alloc, MEM_CUSTOM) == 0)
-            {
-                set_reference_bits(&memory, 1, curr_process_list->pid);
-                // print_array(memory->reference_bit, memory->n_total_pages);
-            }
-            print_process_run(cpu_clock, mem_alloc, curr_process_list->time_load_penalty, memory->mem_usage,
-             memory->n_total_pages, curr_process_list);
+            fprintf(stderr, "Unable to open sweep output file!\n");
+            exit(1);
         }
-        
-        //Checks if cpu_clock corresponds to a newly arrived process, adds to processing queue
-        //if matches
-        if (incoming_processes && has_process_arrived(cpu_clock, incoming_processes))
-        {           
-            //If there are no currently running processes but simulation is still ongoing
-            //and a new process has arrived
-            if (!curr_process_list)
-            {
-                curr_process_list = malloc(sizeof(struct process_t));
-            
-                if(!curr_process_list)
-                {
-                    fprintf(stderr, "Malloc failed!\n");
-                    exit(1);
-                }
-                curr_process_list = list_pop(&incoming_processes);
-                //Loads memory and calculate loading time penalty if not in Unlimited
-                //Memory mode
-                run_memory(&memory, mem_alloc, curr_process_list, cpu_clock);
 
-                //Set reference bit if using cm
-                if (strcmp(mem_alloc, MEM_CUSTOM) == 0)
-                {
-                    set_reference_bits(&memory, 1, curr_process_list->pid);
-                    // print_array(memory->reference_bit, memory->n_total_pages);
-                }
-                print_process_run(cpu_clock, mem_alloc, curr_process_list->time_load_penalty, memory->mem_usage,
-                memory->n_total_pages, curr_process_list);
-            }
-            
-            //If a new process arrived while another process is already running
-            while(incoming_processes && cpu_clock == incoming_processes->arrival_time)
-            {
-                struct process_t *popped_proc = list_pop(&incoming_processes);
-                curr_process_list = list_push(curr_process_list, popped_proc);
-            }
-        }
-        //There are still incoming processes in simulation but no currently running processes
-        if (incoming_processes && !curr_process_list)
-        {
-            cpu_clock += 1;
-            continue;
-        }
-        
-        //ROUND ROBIN SCHEDULING
-        //Decrements quantum after load time penalty
-        if (strcmp(sched_algo, ALGO_ROUNDROBIN) == 0 && curr_process_list->time_load_penalty <= 0)
-        {            
-            //Update quantum time
-            if (quantum_clock > 0)
-            {
-                quantum_clock -= 1; 
-            }
-            else
-            {
-                //Quantum offset from loading penalties  
-                if (strcmp(mem_alloc, MEM_UNLIMITED) == 0 || curr_process_list->next == NULL)
-                {
-                    quantum_clock = quantum - 1;
-                }
-                else
-                {
-                    quantum_clock = quantum;
-                }
-                
-                curr_process_list = round_robin_shuffle(curr_process_list, &memory);
-                            
-                //Loads memory and calculate loading time penalty if not in Unlimited
-                //Memory mode               
-                run_memory(&memory, mem_alloc, curr_process_list, cpu_clock);
+        run_sweep(sweep, arrivals, n_threads);
+        write_sweep_csv(csv, sweep);
 
-                //Set reference bit if using cm
-                if (strcmp(mem_alloc, MEM_CUSTOM) == 0)
-                {
-                    set_reference_bits(&memory, 1, curr_process_list->pid);
-                    // print_array(memory->reference_bit, memory->n_total_pages);
-                }
-                print_process_run(cpu_clock, mem_alloc, curr_process_list->time_load_penalty, memory->mem_usage,
-                 memory->n_total_pages, curr_process_list);
-            }
-        }
-        //Run process
-        fin_flag = execute_process(cpu_clock, &curr_process_list);
+        fclose(csv);
+        free_sweep(sweep);
+        free_arrivals(arrivals);
 
-        //Update clocks
-        cpu_clock += 1;
+        return 0;
     }
 
-    free(incoming_processes);
-    free(mem_alloc);
-    free_datalog(log);
-    free_memory(memory);
-
-    return 0;
-}
-
-void run_memory(struct memory_t **memory, char *mem_alloc, struct process_t *curr_process_list, uint32_t cpu_clock)
-{
-    uint32_t load_penalty = 0, page_fault_penalty = 0;
-    uint32_t *memory_addr = NULL;
+    //Names are looked up in full, a longer name must not match once cut to fit the config
+    if (!find_sched_policy(algo_arg))
+    {
+        fprintf(stderr, "Unknown scheduling algorithm %s!\n", algo_arg);
+        exit(1);
+    }
+    if (!find_mem_policy(mem_arg))
+    {
+        fprintf(stderr, "Unknown memory allocation %s!\n", mem_arg);
+        exit(1);
+    }
 
-    //Running on Unlimited Memory
-    if (strcmp(mem_alloc, MEM_UNLIMITED) == 0 || curr_process_list == NULL)
+    memset(&config, 0, sizeof(struct sim_config_t));
+    snprintf(config.sched_algo, SIZE_ALGO, "%s", algo_arg);
+    snprintf(config.mem_alloc, SIZE_MEMALLOC, "%s", mem_arg);
+    sscanf(size_arg, "%"SCNd32, &config.mem_size);
+    config.quantum = atoi(quantum_arg);
+    //Quiet mode only prints the final statistics, no transcript is formatted
+    config.transcript = quiet ? NULL : open_writer(STDOUT_FILENO, format);
+    if (config.transcript && async)
     {
-        return;
+        start_writer_thread(config.transcript);
     }
-    //Running on Swapping-X mode
-    else if (strcmp(mem_alloc, MEM_SWAPPING_X) == 0)
+
+    //Processes are read from the file as the simulation reaches them
+    if ((sim = sim_create(&config, open_workload(file))) == NULL)
     {
-        memory_addr = create_uint32_array((*memory)->n_total_pages, UINT32_MAX);
-        load_penalty = load_into_memory_p(memory, curr_process_list->pid, curr_process_list->memory_required, 
-        memory_addr, cpu_clock);
-        curr_process_list->time_load_penalty = load_penalty;
-        //Updates memory address if pages were not in memory already before suspension
-        if (load_penalty > 0)
-        {
-            curr_process_list->memory_address = memory_addr;
-        }
-        else
-        {
-            free(memory_addr);
-        }
+        fprintf(stderr, "Unknown scheduling algorithm or memory allocation!\n");
+        exit(1);
     }
-    //Running on Virtual memory mode
-    else if (strcmp(mem_alloc, MEM_VIRTUAL_MEM) == 0)
+
+    //Start CPU simulation
+    sim_run(sim);
+    sim_get_metrics(sim, &stats);
+    sim_destroy(sim);
+
+    //Transcript goes out before the statistics printed through stdio
+    if (config.transcript)
     {
-        memory_addr = create_uint32_array((*memory)->n_total_pages, UINT32_MAX);
-        load_penalty = load_into_memory_v(memory, curr_process_list->pid, curr_process_list->memory_required, 
-        memory_addr, &page_fault_penalty, cpu_clock);
-        curr_process_list->time_load_penalty = load_penalty;
-        curr_process_list->time_required += page_fault_penalty;
-        //Updates memory address if pages were not in memory already before suspension
-        if (load_penalty > 0)
-        {
-            curr_process_list->memory_address = memory_addr;
-        }
-        else
-        {
-            free(memory_addr);
-        }
+        close_writer(config.transcript);
     }
-    //Running on Custom memory mode
-    else if (strcmp(mem_alloc, MEM_CUSTOM) == 0)
+    print_performance_stats(stdout, &stats);
+    if (evictions)
     {
-        memory_addr = create_uint32_array((*memory)->n_total_pages, UINT32_MAX);
-        load_penalty = load_into_memory_cm(memory, curr_process_list->pid, curr_process_list->memory_required, 
-        memory_addr, &page_fault_penalty, cpu_clock);        
-        curr_process_list->time_load_penalty = load_penalty;
-        curr_process_list->time_required += page_fault_penalty;
-        //Updates memory address if pages were not in memory already before suspension
-        if (load_penalty > 0)
-        {
-            curr_process_list->memory_address = memory_addr;
-        }
-        else
-        {
-            free(memory_addr);
-        }
+        print_eviction_stats(stdout, &stats);
     }
-}
\ No newline at end of file
+
+    return 0;
+}
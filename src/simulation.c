@@ -0,0 +1,422 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "../include/utilities.h"
+#include "../include/process_scheduling.h"
+#include "../include/memory.h"
+#include "../include/simulation.h"
+#include "../include/policy.h"
+
+//Scheduling events the CPU clock can jump to
+#define EVENT_ARRIVAL 0
+#define EVENT_LOAD_END 1
+#define EVENT_QUANTUM 2
+#define EVENT_COMPLETION 3
+#define N_EVENTS 4
+
+void sim_tick(struct sim_t *sim);
+struct process_t *pop_arrival(struct sim_t *sim);
+void sim_jump(struct sim_t *sim, uint32_t until);
+void run_memory(struct sim_t *sim);
+uint32_t next_event_time(uint32_t cpu_clock, struct process_t *list, struct process_t *incoming,
+ int quantum_clock, int round_robin);
+
+/*
+Creates a simulation of a workload, with its own memory, run queue and datalog
+!! TAKES OWNERSHIP OF THE WORKLOAD, processes are only read from it as they arrive
+@params
+config, struct sim_config_t *, scheduling algorithm, memory allocation, memory size, quantum
+    and transcript writer, copied into the simulation
+workload, struct workload_t *, the processes in order of arrival
+
+@return
+struct sim_t *, the simulation at time 0, NULL if the configuration is unknown
+*/
+struct sim_t *sim_create(struct sim_config_t *config, struct workload_t *workload)
+{
+    struct sim_t *sim = NULL;
+    struct sched_policy_t *sched = find_sched_policy(config->sched_algo);
+    struct mem_policy_t *mem_policy = find_mem_policy(config->mem_alloc);
+
+    if (!sched || !mem_policy)
+    {
+        return NULL;
+    }
+
+    sim = malloc(sizeof(struct sim_t));
+
+    if (!sim)
+    {
+        fprintf(stderr, "Malloc failed!\n");
+        exit(1);
+    }
+
+    sim->config = *config;
+    sim->sched = sched;
+    sim->mem_policy = mem_policy;
+    sim->quantum_clock = config->quantum;
+    sim->fin_flag = 0;
+    sim->cpu_clock = 0;
+    init_run_queue(&sim->run_queue, sched->job_heap);
+    sim->workload = workload;
+    //A malformed line met midway through the run exits, the transcript before it goes out
+    if (workload->parser)
+    {
+        workload->parser->transcript = config->transcript;
+    }
+    sim->incoming_processes = read_process(workload);
+    sim->log = init_datalog();
+    sim->memory = init_memory(config->mem_size);
+    sim->memory->transcript = config->transcript;
+    //Nothing to simulate
+    sim->finished = (sim->incoming_processes == NULL);
+
+    return sim;
+}
+
+/*
+Runs the simulation until every process has finished
+@params
+sim, struct sim_t *, the simulation
+*/
+void sim_run(struct sim_t *sim)
+{
+    sim_step_until(sim, UINT32_MAX);
+}
+
+/*
+Runs the simulation up to, but not including, the given tick, or until every process
+has finished if earlier
+@params
+sim, struct sim_t *, the simulation
+until, uint32_t, time in Seconds to stop at
+
+@return
+int, 1 if every process has finished, else 0
+*/
+int sim_step_until(struct sim_t *sim, uint32_t until)
+{
+    while (!sim->finished && sim->cpu_clock < until)
+    {
+        //Jumps the clock straight to the next scheduling event, running the current
+        //process through all the ticks in between
+        if (!sim->fin_flag && sim->cpu_clock > 0)
+        {
+            sim_jump(sim, until);
+
+            if (sim->cpu_clock >= until)
+            {
+                break;
+            }
+        }
+
+        sim_tick(sim);
+    }
+
+    return sim->finished;
+}
+
+/*
+Calculates the performance statistics of the simulation so far, with the pages evicted
+to make room for loads
+@params
+sim, struct sim_t *, the simulation
+stats, struct perf_stats_t *, stores the calculated statistics
+*/
+void sim_get_metrics(struct sim_t *sim, struct perf_stats_t *stats)
+{
+    get_performance_stats(sim->cpu_clock, sim->log, stats);
+    stats->evictions = sim->memory->total_evicted;
+}
+
+/*
+Frees up the simulation, including every process left in it
+@params
+sim, struct sim_t *, the simulation to be freed
+*/
+void sim_destroy(struct sim_t *sim)
+{
+    //Every process still in the simulation goes with the workload's pool
+    free_run_queue(&sim->run_queue);
+    close_workload(sim->workload);
+    free_datalog(sim->log);
+    free_memory(sim->memory);
+    free(sim);
+}
+
+/*
+Pops the next process to arrive, reading the one after it from the workload
+@params
+sim, struct sim_t *, the simulation
+
+@return
+struct process_t *, the process that arrived
+*/
+struct process_t *pop_arrival(struct sim_t *sim)
+{
+    struct process_t *arrival = sim->incoming_processes;
+
+    sim->incoming_processes = read_process(sim->workload);
+
+    return arrival;
+}
+
+/*
+Advances the clock to the next scheduling event, capped at the given time, running the
+current process through all the ticks in between
+@params
+sim, struct sim_t *, the simulation
+until, uint32_t, time in Seconds not to go past
+*/
+void sim_jump(struct sim_t *sim, uint32_t until)
+{
+    uint32_t next_event = next_event_time(sim->cpu_clock, sim->run_queue.head, sim->incoming_processes,
+     sim->quantum_clock, sim->sched->on_quantum_expiry != NULL);
+
+    if (next_event > until)
+    {
+        next_event = until;
+    }
+
+    if (next_event > sim->cpu_clock)
+    {
+        if (sim->run_queue.head)
+        {
+            uint32_t run_ticks = execute_process_ticks(sim->cpu_clock, next_event - sim->cpu_clock,
+             &sim->run_queue.head);
+
+            if (sim->sched->on_quantum_expiry)
+            {
+                sim->quantum_clock -= run_ticks;
+            }
+        }
+        sim->cpu_clock = next_event;
+    }
+}
+
+/*
+Simulates the scheduling events at the current tick and runs the current process for it
+@params
+sim, struct sim_t *, the simulation
+*/
+void sim_tick(struct sim_t *sim)
+{
+    //If a process finished running from last tick, print RUNNING transcript and handle
+    //transitions
+    if (sim->fin_flag && sim->run_queue.head)
+    {
+        struct process_t *junk;
+        sim->run_queue.head->time_finished = sim->cpu_clock;
+        
+        //Handles memory eviction for finished process
+        sim->mem_policy->evict(&sim->memory, sim->run_queue.head, sim->cpu_clock);
+        print_process_finish(sim->config.transcript, sim->cpu_clock, sim->run_queue.head,
+         sim->run_queue.length - 1);
+
+        junk = queue_pop(&sim->run_queue);
+        //For performance statistics
+        add_fin_process(sim->log, junk);
+        release_process(sim->workload, junk);
+        
+        //If no more processes to run, stop simulation.
+        if (!sim->incoming_processes && !sim->run_queue.head)
+        {
+
+            sim->finished = 1;
+            return;
+        }          
+        
+        //Choose the process to run next
+        sim->sched->pick_next(&sim->run_queue);
+
+        run_memory(sim);
+
+        sim->fin_flag = 0; 
+        sim->quantum_clock = sim->config.quantum;   
+
+        //There are still incoming processes in simulation but no currently running processes
+        if (sim->incoming_processes && !sim->run_queue.head)
+        {            
+            return;
+        }
+
+        print_process_run(sim->config.transcript, sim->cpu_clock, sim->mem_policy->unlimited,
+         sim->run_queue.head->time_load_penalty, memory_usage(sim->memory), sim->run_queue.head);        
+    }
+
+    //Run first process at time 0
+    if (sim->cpu_clock == 0)
+    {
+        queue_push(&sim->run_queue, pop_arrival(sim));
+        
+        //To sort pid if at time 0 has > 1 processes arriving
+        while(sim->incoming_processes && sim->cpu_clock == sim->incoming_processes->arrival_time)
+        {
+            sim->sched->on_arrival(&sim->run_queue, pop_arrival(sim));              
+        }
+
+        //Choose the process to run next
+        sim->sched->pick_next(&sim->run_queue);
+        
+        //Loads memory and calculate loading time penalty if not in Unlimited
+        //Memory mode
+        run_memory(sim);
+        print_process_run(sim->config.transcript, sim->cpu_clock, sim->mem_policy->unlimited,
+         sim->run_queue.head->time_load_penalty, memory_usage(sim->memory), sim->run_queue.head);
+    }
+    
+    //Checks if sim->cpu_clock corresponds to a newly arrived process, adds to processing queue
+    //if matches
+    if (sim->incoming_processes && has_process_arrived(sim->cpu_clock, sim->incoming_processes))
+    {           
+        //If there are no currently running processes but simulation is still ongoing
+        //and a new process has arrived
+        if (!sim->run_queue.head)
+        {
+            queue_push(&sim->run_queue, pop_arrival(sim));
+            //Loads memory and calculate loading time penalty if not in Unlimited
+            //Memory mode
+            run_memory(sim);
+            print_process_run(sim->config.transcript, sim->cpu_clock, sim->mem_policy->unlimited,
+            sim->run_queue.head->time_load_penalty, memory_usage(sim->memory), sim->run_queue.head);
+        }
+        
+        //If a new process arrived while another process is already running
+        while(sim->incoming_processes && sim->cpu_clock == sim->incoming_processes->arrival_time)
+        {
+            struct process_t *popped_proc = pop_arrival(sim);
+            sim->sched->on_arrival(&sim->run_queue, popped_proc);
+        }
+    }
+    //There are still incoming processes in simulation but no currently running processes
+    if (sim->incoming_processes && !sim->run_queue.head)
+    {
+        sim->cpu_clock += 1;
+        return;
+    }
+    
+    //ROUND ROBIN SCHEDULING
+    //Decrements quantum after load time penalty
+    if (sim->sched->on_quantum_expiry && sim->run_queue.head->time_load_penalty <= 0)
+    {            
+        //Update quantum time
+        if (sim->quantum_clock > 0)
+        {
+            sim->quantum_clock -= 1; 
+        }
+        else
+        {
+            //Quantum offset from loading penalties  
+            if (sim->mem_policy->unlimited || sim->run_queue.head->next == NULL)
+            {
+                sim->quantum_clock = sim->config.quantum - 1;
+            }
+            else
+            {
+                sim->quantum_clock = sim->config.quantum;
+            }
+            
+            sim->sched->on_quantum_expiry(&sim->run_queue, &sim->memory);
+                        
+            //Loads memory and calculate loading time penalty if not in Unlimited
+            //Memory mode               
+            run_memory(sim);
+            print_process_run(sim->config.transcript, sim->cpu_clock, sim->mem_policy->unlimited,
+             sim->run_queue.head->time_load_penalty, memory_usage(sim->memory), sim->run_queue.head);
+        }
+    }
+    //Run process
+    sim->fin_flag = execute_process(sim->cpu_clock, &sim->run_queue.head);
+
+    //Update clocks
+    sim->cpu_clock += 1;
+}
+
+/*
+Loads the pages of the process at the head of the run queue into memory as per the
+memory policy of the simulation, and updates its bookkeeping for running
+@params
+sim, struct sim_t *, the simulation
+*/
+void run_memory(struct sim_t *sim)
+{
+    if (sim->run_queue.head == NULL)
+    {
+        return;
+    }
+
+    sim->mem_policy->load(&sim->memory, sim->run_queue.head, sim->cpu_clock);
+    sim->mem_policy->on_run(&sim->memory, sim->run_queue.head);
+}
+
+/*
+Finds the earliest tick at which the simulation has to do more than count down the
+running process, being the next arrival, the end of the loading penalty, the quantum
+expiry under Round-Robin, or the tick in which the running process completes
+@params
+cpu_clock, uint32_t, representation of CPU clock in Seconds
+list, struct process_t *, the running process list, NULL if idle
+incoming, struct process_t *, the processes yet to arrive
+quantum_clock, int, the quantum remaining for the running process
+round_robin, int, 1 if running Round-Robin scheduling, else 0
+
+@return
+uint32_t, time of the next event in Seconds, cpu_clock if it is happening now
+*/
+uint32_t next_event_time(uint32_t cpu_clock, struct process_t *list, struct process_t *incoming,
+ int quantum_clock, int round_robin)
+{
+    uint64_t events[N_EVENTS];
+    uint64_t penalty_end = 0, next_event = UINT64_MAX;
+
+    for (int i = 0; i < N_EVENTS; i++)
+    {
+        events[i] = UINT64_MAX;
+    }
+
+    //Processes only arrive when the clock matches their arrival time exactly
+    if (incoming && incoming->arrival_time >= cpu_clock)
+    {
+        events[EVENT_ARRIVAL] = incoming->arrival_time;
+    }
+
+    if (list)
+    {
+        penalty_end = (uint64_t) cpu_clock + list->time_load_penalty;
+
+        if (list->time_load_penalty > 0)
+        {
+            events[EVENT_LOAD_END] = penalty_end;
+        }
+        //Quantum only counts down once the loading penalty is over
+        if (round_robin)
+        {
+            events[EVENT_QUANTUM] = penalty_end + (quantum_clock > 0 ? quantum_clock : 0);
+        }
+        //Tick in which the last second of the job executes
+        if (list->time_required > 0)
+        {
+            events[EVENT_COMPLETION] = penalty_end + list->time_required - 1;
+        }
+        else
+        {
+            events[EVENT_COMPLETION] = cpu_clock;
+        }
+    }
+
+    for (int i = 0; i < N_EVENTS; i++)
+    {
+        if (events[i] < next_event)
+        {
+            next_event = events[i];
+        }
+    }
+
+    //No known event, tick as usual
+    if (next_event > UINT32_MAX)
+    {
+        return cpu_clock;
+    }
+
+    return (uint32_t) next_event;
+}
\ No newline at end of file
@@ -0,0 +1,275 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "../include/sweep.h"
+#include "../include/simulation.h"
+#include "../include/process_scheduling.h"
+#include "../include/utilities.h"
+#include "../include/policy.h"
+
+#define LIST_DELIM ","
+
+uint32_t split_list(char *list, char ***items);
+void free_split_list(char **items, uint32_t n);
+void *sweep_worker(void *arg);
+
+/*
+Initialises a parameter sweep over every combination of the given parameter lists
+!! Exits on an unknown scheduling algorithm or memory allocation
+!! QUANTA ONLY APPLY TO PREEMPTIVE ALGORITHMS, THE OTHERS GET ONE CONFIGURATION WITH QUANTUM 0
+@params
+algos, char *, comma separated scheduling algorithms, i.e. "ff,rr,cs"
+mem_allocs, char *, comma separated memory allocations, i.e. "u,p,v,cm"
+mem_sizes, char *, comma separated memory sizes in KB
+quanta, char *, comma separated quanta in Seconds
+
+@return
+struct sweep_t *, the initialised sweep
+*/
+struct sweep_t *init_sweep(char *algos, char *mem_allocs, char *mem_sizes, char *quanta)
+{
+    struct sweep_t *sweep = malloc(sizeof(struct sweep_t));
+    char **algo_list = NULL, **mem_list = NULL, **size_list = NULL, **quantum_list = NULL;
+    uint32_t n_algo = split_list(algos, &algo_list);
+    uint32_t n_mem = split_list(mem_allocs, &mem_list);
+    uint32_t n_size = split_list(mem_sizes, &size_list);
+    uint32_t n_quantum = split_list(quanta, &quantum_list);
+    uint32_t n = 0, n_algo_quanta = 0;
+    struct sched_policy_t *sched = NULL;
+
+    if (!sweep)
+    {
+        fprintf(stderr, "Malloc failed!\n");
+        exit(1);
+    }
+
+    for (uint32_t a = 0; a < n_algo; a++)
+    {
+        if (!(sched = find_sched_policy(algo_list[a])))
+        {
+            fprintf(stderr, "Unknown scheduling algorithm %s!\n", algo_list[a]);
+            exit(1);
+        }
+        n_algo_quanta += sched->on_quantum_expiry ? n_quantum : 1;
+    }
+    for (uint32_t m = 0; m < n_mem; m++)
+    {
+        if (!find_mem_policy(mem_list[m]))
+        {
+            fprintf(stderr, "Unknown memory allocation %s!\n", mem_list[m]);
+            exit(1);
+        }
+    }
+
+    sweep->n_configs = n_algo_quanta * n_mem * n_size;
+    sweep->next_config = 0;
+    sweep->arrivals = NULL;
+    sweep->configs = calloc(sweep->n_configs, sizeof(struct sim_config_t));
+    sweep->results = calloc(sweep->n_configs, sizeof(struct perf_stats_t));
+
+    if ((!sweep->configs || !sweep->results) && sweep->n_configs > 0)
+    {
+        fprintf(stderr, "Malloc failed!\n");
+        exit(1);
+    }
+
+    for (uint32_t a = 0; a < n_algo; a++)
+    {
+        //Non-preemptive algorithms never look at the quantum, so one run covers them all
+        sched = find_sched_policy(algo_list[a]);
+        n_algo_quanta = sched->on_quantum_expiry ? n_quantum : 1;
+
+        for (uint32_t m = 0; m < n_mem; m++)
+        {
+            for (uint32_t s = 0; s < n_size; s++)
+            {
+                for (uint32_t q = 0; q < n_algo_quanta; q++)
+                {
+                    strcpy(sweep->configs[n].sched_algo, algo_list[a]);
+                    strcpy(sweep->configs[n].mem_alloc, mem_list[m]);
+                    sscanf(size_list[s], "%"SCNd32, &sweep->configs[n].mem_size);
+                    sweep->configs[n].quantum = sched->on_quantum_expiry ? atoi(quantum_list[q]) : 0;
+                    sweep->configs[n].transcript = NULL;
+                    n += 1;
+                }
+            }
+        }
+    }
+
+    free_split_list(algo_list, n_algo);
+    free_split_list(mem_list, n_mem);
+    free_split_list(size_list, n_size);
+    free_split_list(quantum_list, n_quantum);
+
+    return sweep;
+}
+
+/*
+Runs every configuration of the sweep over the same workload on a pool of threads,
+each simulation reads the shared arrivals and has its own processes, memory and run queues
+@params
+sweep, struct sweep_t *, the initialised sweep
+arrivals, const struct arrivals_t *, the parsed arrivals, only ever read
+n_threads, int, number of threads, one per online CPU if <= 0
+*/
+void run_sweep(struct sweep_t *sweep, const struct arrivals_t *arrivals, int n_threads)
+{
+    pthread_t *threads = NULL;
+
+    if (n_threads <= 0)
+    {
+        n_threads = (int) sysconf(_SC_NPROCESSORS_ONLN);
+    }
+    if (n_threads <= 0)
+    {
+        n_threads = 1;
+    }
+    if ((uint32_t) n_threads > sweep->n_configs)
+    {
+        n_threads = (int) sweep->n_configs;
+    }
+
+    sweep->arrivals = arrivals;
+    sweep->next_config = 0;
+    threads = malloc(sizeof(pthread_t) * (n_threads > 0 ? n_threads : 1));
+
+    if (!threads)
+    {
+        fprintf(stderr, "Malloc failed!\n");
+        exit(1);
+    }
+
+    for (int i = 0; i < n_threads; i++)
+    {
+        if (pthread_create(&threads[i], NULL, sweep_worker, sweep) != 0)
+        {
+            fprintf(stderr, "Unable to create sweep thread!\n");
+            exit(1);
+        }
+    }
+    for (int i = 0; i < n_threads; i++)
+    {
+        pthread_join(threads[i], NULL);
+    }
+
+    free(threads);
+}
+
+/*
+Writes one row of performance statistics per sweep configuration, in CSV format
+@params
+out, FILE *, the CSV output stream
+sweep, struct sweep_t *, a sweep that has been run
+*/
+void write_sweep_csv(FILE *out, struct sweep_t *sweep)
+{
+    fprintf(out, "algorithm,memory,mem_size,quantum,throughput_avg,throughput_min,throughput_max,"
+     "turnaround,overhead_max,overhead_avg,makespan,evictions\n");
+
+    for (uint32_t i = 0; i < sweep->n_configs; i++)
+    {
+        struct sim_config_t *config = &sweep->configs[i];
+        struct perf_stats_t *stats = &sweep->results[i];
+
+        fprintf(out, "%s,%s,%"PRIu32",%d,%"PRIu32",%"PRIu32",%"PRIu32",%d,%.2f,%.2f,%"PRIu32",%"PRIu64"\n",
+         config->sched_algo, config->mem_alloc, config->mem_size, config->quantum,
+         stats->throughput[0], stats->throughput[1], stats->throughput[2], stats->turnaround,
+         stats->overhead[0], stats->overhead[1], stats->makespan, stats->evictions);
+    }
+}
+
+/*
+Frees up the sweep_t data struct, but not the arrivals
+@params
+sweep, struct sweep_t *, the sweep to be freed
+*/
+void free_sweep(struct sweep_t *sweep)
+{
+    free(sweep->configs);
+    free(sweep->results);
+    free(sweep);
+}
+
+/*
+Runs sweep configurations until none are left, claiming one at a time
+@params
+arg, void *, the struct sweep_t * being run
+
+@return
+void *, NULL
+*/
+void *sweep_worker(void *arg)
+{
+    struct sweep_t *sweep = (struct sweep_t *) arg;
+    uint32_t i = 0;
+
+    while ((i = __sync_fetch_and_add(&sweep->next_config, 1)) < sweep->n_configs)
+    {
+        struct sim_t *sim = sim_create(&sweep->configs[i], open_shared_workload(sweep->arrivals));
+
+        sim_run(sim);
+        sim_get_metrics(sim, &sweep->results[i]);
+        sim_destroy(sim);
+    }
+
+    return NULL;
+}
+
+/*
+Splits a comma separated list into a newly allocated array of items
+@params
+list, char *, the comma separated list, left untouched
+items, char ***, stores the array of items
+
+@return
+uint32_t, number of items in the list
+*/
+uint32_t split_list(char *list, char ***items)
+{
+    char *copy = strdup(list);
+    char *saveptr = NULL;
+    char *item = NULL;
+    uint32_t n = 0;
+
+    *items = malloc(sizeof(char *) * (strlen(list) + 1));
+
+    if (!copy || !*items)
+    {
+        fprintf(stderr, "Malloc failed!\n");
+        exit(1);
+    }
+
+    for (item = strtok_r(copy, LIST_DELIM, &saveptr); item != NULL; item = strtok_r(NULL, LIST_DELIM, &saveptr))
+    {
+        (*items)[n] = strdup(item);
+        n += 1;
+    }
+    free(copy);
+
+    if (n == 0)
+    {
+        fprintf(stderr, "Empty sweep parameter list!\n");
+        exit(1);
+    }
+
+    return n;
+}
+
+/*
+Frees up an array of items from split_list()
+@params
+items, char **, the array of items
+n, uint32_t, number of items
+*/
+void free_split_list(char **items, uint32_t n)
+{
+    for (uint32_t i = 0; i < n; i++)
+    {
+        free(items[i]);
+    }
+    free(items);
+}
@@ -0,0 +1,137 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include "../include/trace.h"
+#include "../include/parser.h"
+
+/*
+Checks if mapped input data is a binary trace, validating its header against its size
+!! EXITS IF THE DATA STARTS WITH THE TRACE MAGIC BUT IS NOT A VALID TRACE
+@params
+data, const char *, the input data, aligned to at least 8 bytes
+size, size_t, the size of the input data in bytes
+
+@return
+const struct trace_header_t *, the trace header, NULL if the data is not a binary trace
+*/
+const struct trace_header_t *open_trace(const char *data, size_t size)
+{
+    const struct trace_header_t *header = (const struct trace_header_t *)data;
+
+    if (size < sizeof(struct trace_header_t) || memcmp(header->magic, TRACE_MAGIC, 4) != 0)
+    {
+        return NULL;
+    }
+
+    if (header->version != TRACE_VERSION)
+    {
+        fprintf(stderr, "Unsupported binary trace version %"PRIu32"!\n", header->version);
+        exit(1);
+    }
+
+    if ((size - sizeof(struct trace_header_t)) / (N_TRACE_COLUMNS * sizeof(uint32_t)) != header->n_processes
+        || (size - sizeof(struct trace_header_t)) % (N_TRACE_COLUMNS * sizeof(uint32_t)) != 0)
+    {
+        fprintf(stderr, "Binary trace size does not match its header!\n");
+        exit(1);
+    }
+
+    return header;
+}
+
+/*
+Gets one column array of a binary trace
+@params
+header, const struct trace_header_t *, the trace header
+column, int, one of TRACE_ARRIVAL, TRACE_PID, TRACE_MEMORY or TRACE_TIME
+
+@return
+const uint32_t *, the column, n_processes long
+*/
+const uint32_t *trace_column(const struct trace_header_t *header, int column)
+{
+    return (const uint32_t *)(header + 1) + column * header->n_processes;
+}
+
+/*
+Converts a text trace into the binary trace format
+!! TWO PASSES OVER THE INPUT: THE FIRST COUNTS PROCESSES AND FINDS COLUMN RANGES,
+!! THE SECOND FILLS THE COLUMNS OF THE MAPPED OUTPUT FILE
+!! CLOSES BOTH FILES
+@params
+in, FILE *, the text trace
+out, FILE *, the binary trace to write, must be a regular file opened for reading and writing
+*/
+void convert_trace(FILE *in, FILE *out)
+{
+    struct parser_t *parser = open_parser(in);
+    struct trace_header_t header;
+    uint32_t values[N_TRACE_COLUMNS];
+    uint32_t *columns[N_TRACE_COLUMNS];
+    size_t size = 0;
+    char *data = NULL;
+
+    if (parser->trace)
+    {
+        fprintf(stderr, "Input is already a binary trace!\n");
+        exit(1);
+    }
+    //A pipe cannot be read twice, both passes run over the whole input in memory
+    if (!parser->mapped)
+    {
+        read_whole_file(parser);
+    }
+
+    memset(&header, 0, sizeof(struct trace_header_t));
+    memcpy(header.magic, TRACE_MAGIC, 4);
+    header.version = TRACE_VERSION;
+
+    //First pass, count processes and track the range of every column
+    while (parse_process_line(parser, &values[TRACE_ARRIVAL], &values[TRACE_PID],
+    &values[TRACE_MEMORY], &values[TRACE_TIME]))
+    {
+        for (int i=0; i < N_TRACE_COLUMNS; i++)
+        {
+            if (header.n_processes == 0 || values[i] < header.min[i])
+            {
+                header.min[i] = values[i];
+            }
+            if (header.n_processes == 0 || values[i] > header.max[i])
+            {
+                header.max[i] = values[i];
+            }
+        }
+        header.n_processes += 1;
+    }
+
+    size = sizeof(struct trace_header_t) + header.n_processes * N_TRACE_COLUMNS * sizeof(uint32_t);
+
+    if (ftruncate(fileno(out), size) != 0
+        || (data = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fileno(out), 0)) == MAP_FAILED)
+    {
+        fprintf(stderr, "Unable to write binary trace!\n");
+        exit(1);
+    }
+
+    memcpy(data, &header, sizeof(struct trace_header_t));
+    for (int i=0; i < N_TRACE_COLUMNS; i++)
+    {
+        columns[i] = (uint32_t *)trace_column((struct trace_header_t *)data, i);
+    }
+
+    //Second pass, scatter every process into its column slots
+    rewind_parser(parser);
+    for (uint64_t n=0; n < header.n_processes; n++)
+    {
+        parse_process_line(parser, &columns[TRACE_ARRIVAL][n], &columns[TRACE_PID][n],
+        &columns[TRACE_MEMORY][n], &columns[TRACE_TIME][n]);
+    }
+
+    munmap(data, size);
+    close_parser(parser);
+    fclose(out);
+}
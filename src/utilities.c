@@ -10,7 +10,6 @@
 #define THROUGHPUT_INTERVAL 60
 #define N_THROUGHPUT_METRIC 3
 #define N_OVERHEAD_METRIC 2
-#define MEM_UNLIMITED "u"
 
 int get_turnaround_time(struct datalog_t *log);
 uint32_t *get_throughput(struct datalog_t *log, uint32_t cpu_clock);
@@ -25,14 +24,24 @@ struct datalog_t *init_datalog()
 {
     struct datalog_t *log = malloc(sizeof(struct datalog_t));
 
+    if (!log)
+    {
+        fprintf(stderr, "Malloc failed!\n");
+        exit(1);
+    }
+
     log->n_proc_fin = 0;
-    log->finished_process = NULL;
+    log->sum_turnaround = 0.0;
+    log->sum_overhead = 0.0;
+    log->max_overhead = 0.0;
+    log->n_intervals = 0;
+    log->interval_list = NULL;
 
     return log;
 }
 
 /*
-Updates finished process' stats into the log
+Updates finished process' stats into the log, only the running totals are kept
 @params
 log, struct datalog_t *, the datalog struct
 process, struct datalog_t *, the finished process
@@ -42,23 +51,55 @@ stuct datalog_t *, the updated log
 */
 struct datalog_t *add_fin_process(struct datalog_t *log, struct process_t *process)
 {
-    struct process_t *curr = log->finished_process;
+    double turnaround_time = process->time_finished - process->arrival_time;
+    double overhead = turnaround_time / ((double)process->job_time);
+    uint32_t index = 0;
 
     log->n_proc_fin += 1;
 
-    //For empty list
-    if (log->finished_process == NULL)
+    //For turnaround time
+    log->sum_turnaround += turnaround_time;
+
+    //For average and maximum overhead time
+    log->sum_overhead += overhead;
+    if (overhead > log->max_overhead)
     {
-        log->finished_process = process;
-        return log;
+        log->max_overhead = overhead;
     }
 
-    while (curr->next != NULL)
+    //Count process in the throughput interval it finished in
+    if (process->time_finished % THROUGHPUT_INTERVAL == 0)
+    {
+        index = ((uint32_t) ceil((process->time_finished - 10) / THROUGHPUT_INTERVAL));
+    }
+    else
     {
-        curr = curr-> next;
+        index = ((uint32_t) ceil((process->time_finished - 1) / THROUGHPUT_INTERVAL));
     }
 
-    curr->next = process;
+    //Grow interval list to fit
+    if (index >= log->n_intervals)
+    {
+        uint32_t n_intervals = log->n_intervals > 0 ? log->n_intervals : 1;
+
+        while (n_intervals <= index)
+        {
+            n_intervals *= 2;
+        }
+        log->interval_list = realloc(log->interval_list, sizeof(uint32_t) * n_intervals);
+
+        if (!log->interval_list)
+        {
+            fprintf(stderr, "Malloc failed!\n");
+            exit(1);
+        }
+        for (uint32_t i = log->n_intervals; i < n_intervals; i++)
+        {
+            log->interval_list[i] = 0;
+        }
+        log->n_intervals = n_intervals;
+    }
+    log->interval_list[index] += 1;
 
     return log;
 }
@@ -70,7 +111,7 @@ log, struct datalog_t, the log to be free
 */
 void free_datalog(struct datalog_t *log)
 {
-    free_list(log->finished_process);
+    free(log->interval_list);
     free(log);
 }
 
@@ -78,93 +119,166 @@ void free_datalog(struct datalog_t *log)
 Prints out the transcript as listed in project specs for RUNNING
 !! Usable for both Unlimited Memory and Limited Memory
 @params
+out, struct writer_t *, the transcript writer, nothing is printed if NULL
 cpu_clock, uint32_t, representation of CPU clock in Seconds
 flag_unlimited, int, flag to represent Unlimited Memory 
 load_time, uint32_t, the time in seconds, to load the pages into memory
-    , ignored if mem_option=="u"
-mem_usage, int, rounded up percentage of memory usage, ignored if mem_option=="u"
-n_mem_addr, uint32_t, max size of mem_addr array
+    , ignored if flag_unlimited
+mem_usage, int, rounded up percentage of memory usage, ignored if flag_unlimited
 process, struct process_t *, the process linked list, prints first element only
 */
-void print_process_run(uint32_t cpu_clock, char *mem_alloc, uint32_t load_time, int mem_usage, 
-uint32_t n_mem_addr, struct process_t *process)
+void print_process_run(struct writer_t *out, uint32_t cpu_clock, int flag_unlimited, uint32_t load_time, int mem_usage, 
+struct process_t *process)
 {
-    //If the scheduler is running on unlimited memory mode
-    if ((strcmp(mem_alloc, MEM_UNLIMITED) == 0))
+    struct log_event_t event;
+
+    if (!out)
     {
-        printf("%"PRIu32", RUNNING, id=%d, remaining-time=%d\n", cpu_clock, process->pid, process->time_required);
+        return;
     }
-    else
-    {
-        printf("%"PRIu32", RUNNING, id=%"PRIu32", remaining-time=%"PRIu32", load-time=%"PRIu32", mem-usage=%d%%, mem-addresses=",
-         cpu_clock, process->pid ,process->time_required, load_time, mem_usage);
 
-        printf("[%"PRIu32, process->memory_address[0]);
-    
-        for (uint32_t i = 1; i < n_mem_addr; i++)
-        {
-            if (process->memory_address[i] == UINT32_MAX)
-            {
-                break;
-            }
-            printf(",%"PRIu32, process->memory_address[i]);
-        }
-        printf("]\n");
+    memset(&event, 0, sizeof(struct log_event_t));
+    event.type = LOG_RUNNING;
+    event.cpu_clock = cpu_clock;
+    event.pid = process->pid;
+    event.time_required = process->time_required;
+    event.flag_unlimited = flag_unlimited;
 
+    //If the scheduler is not running on unlimited memory mode
+    if (!flag_unlimited)
+    {
+        event.load_time = load_time;
+        event.mem_usage = mem_usage;
+        event.n_mem_addr = process->n_memory_address;
     }
+
+    write_event(out, &event, process->memory_address);
 }
 
 /*
 Prints out the transcript as listed in project specs for EVICTED 
 @params
+out, struct writer_t *, the transcript writer, nothing is printed if NULL
 cpu_clock, uint32_t, representation of CPU clock in Seconds
-mem_address, uint32_t *, array of evicted memory addresses
+mem_address, uint32_t *, array of evicted memory addresses, nothing is printed if NULL
 n_mem_addr, uint32_t, size of mem_address
 */
-void print_memory_evict(uint32_t cpu_clock, uint32_t *mem_address, uint32_t n_mem_addr) 
+void print_memory_evict(struct writer_t *out, uint32_t cpu_clock, uint32_t *mem_address, uint32_t n_mem_addr) 
 {
-    printf("%"PRIu32", EVICTED, mem-addresses=[%"PRIu32, cpu_clock, mem_address[0]);
-    for (uint32_t i = 1; i < n_mem_addr; i++)
+    struct log_event_t event;
+
+    //Nothing was evicted
+    if (!out || !mem_address)
     {
-        if (mem_address[i] == UINT32_MAX)
-        {
-            break;
-        }
-        printf(",%d", mem_address[i]);
+        return;
+    }
+
+    memset(&event, 0, sizeof(struct log_event_t));
+    event.type = LOG_EVICTED;
+    event.cpu_clock = cpu_clock;
+    event.n_mem_addr = 1;
+
+    while (event.n_mem_addr < n_mem_addr && mem_address[event.n_mem_addr] != UINT32_MAX)
+    {
+        event.n_mem_addr += 1;
     }
-    printf("]\n");
+
+    write_event(out, &event, mem_address);
 }
 
 /*
 Prints out the transcript as listed in project specs for FINISHED
 @params
+out, struct writer_t *, the transcript writer, nothing is printed if NULL
 cpu_clock, uint32_t, representation of CPU clock in Seconds
-process, struct process_t *, the process linked list, prints first element only
+process, struct process_t *, the finished process
+proc_remaining, uint32_t, number of processes still waiting in the run queue
 */
-void print_process_finish(uint32_t cpu_clock, struct process_t *process) 
+void print_process_finish(struct writer_t *out, uint32_t cpu_clock, struct process_t *process, uint32_t proc_remaining) 
 {
-    printf("%"PRIu32", FINISHED, id=%"PRIu32", proc-remaining=%"PRIu32"\n", cpu_clock, process->pid, count_processes(process)-1);
+    struct log_event_t event;
+
+    if (!out)
+    {
+        return;
+    }
+
+    memset(&event, 0, sizeof(struct log_event_t));
+    event.type = LOG_FINISHED;
+    event.cpu_clock = cpu_clock;
+    event.pid = process->pid;
+    event.proc_remaining = proc_remaining;
+
+    write_event(out, &event, NULL);
 }
 
-void print_performance_stats(uint32_t cpu_clock, struct datalog_t *log)
+/*
+Calculates the performance statistics listed in project specs from the finished processes
+@params
+cpu_clock, uint32_t, representation of CPU clock in Seconds, at the end of simulation
+log, struct datalog_t *, datalog
+stats, struct perf_stats_t *, stores the calculated statistics
+*/
+void get_performance_stats(uint32_t cpu_clock, struct datalog_t *log, struct perf_stats_t *stats)
 {
-    int turnaround = 0;
     uint32_t *throughput = NULL;
     double *overhead = NULL;
 
+    memset(stats, 0, sizeof(struct perf_stats_t));
+    stats->makespan = cpu_clock;
+
+    //No process has finished
+    if (log->n_proc_fin == 0)
+    {
+        return;
+    }
+
     //Calculate throughput
     throughput = get_throughput(log, cpu_clock);
 
     //Calculate turnaround time
-    turnaround = get_turnaround_time(log);
+    stats->turnaround = get_turnaround_time(log);
 
     //Calculate overhead
     overhead = get_overhead(log);
 
-    printf("Throughput %"PRIu32", %"PRIu32", %"PRIu32"\n", throughput[0], throughput[1], throughput[2]);
-    printf("Turnaround time %"PRIu32"\n", turnaround);
-    printf("Time overhead %.2f %.2f\n", overhead[0], overhead[1]);
-    printf("Makespan %"PRIu32"\n", cpu_clock);
+    for (int i = 0; i < N_THROUGHPUT_METRIC; i++)
+    {
+        stats->throughput[i] = throughput[i];
+    }
+    for (int i = 0; i < N_OVERHEAD_METRIC; i++)
+    {
+        stats->overhead[i] = overhead[i];
+    }
+
+    free(throughput);
+    free(overhead);
+}
+
+/*
+Prints out the performance statistics as listed in project specs
+@params
+out, FILE *, the transcript stream
+stats, struct perf_stats_t *, the calculated statistics
+*/
+void print_performance_stats(FILE *out, struct perf_stats_t *stats)
+{
+    fprintf(out, "Throughput %"PRIu32", %"PRIu32", %"PRIu32"\n", stats->throughput[0], stats->throughput[1],
+     stats->throughput[2]);
+    fprintf(out, "Turnaround time %"PRIu32"\n", stats->turnaround);
+    fprintf(out, "Time overhead %.2f %.2f\n", stats->overhead[0], stats->overhead[1]);
+    fprintf(out, "Makespan %"PRIu32"\n", stats->makespan);
+}
+
+/*
+Prints out the number of pages evicted to make room for loads, not part of project specs
+@params
+out, FILE *, the transcript stream
+stats, struct perf_stats_t *, the calculated statistics
+*/
+void print_eviction_stats(FILE *out, struct perf_stats_t *stats)
+{
+    fprintf(out, "Evictions %"PRIu64"\n", stats->evictions);
 }
 
 /*
@@ -178,15 +292,9 @@ int, turnaround time
 */
 int get_turnaround_time(struct datalog_t *log)
 {
-    double sum_for_turnaround = 0.0;
+    double sum_for_turnaround = log->sum_turnaround;
     int turnaround = 0;
 
-    //Calculating turnaround time
-    for (struct process_t *curr = log->finished_process; curr != NULL; curr=curr->next)
-    {
-        sum_for_turnaround += (curr->time_finished - curr->arrival_time);
-    }
-
     sum_for_turnaround /= log->n_proc_fin;
     turnaround = ceil(sum_for_turnaround);
 
@@ -206,42 +314,30 @@ uint32_t *, [average, min, max]
 uint32_t *get_throughput(struct datalog_t *log, uint32_t cpu_clock)
 {
     uint32_t *ret_val = NULL;
-    //Determine how many intervals the array should have
+    //Determine how many intervals the array should have, a trailing partial interval
+    //is not part of the metrics
     uint32_t size = (uint32_t) ceil(cpu_clock / THROUGHPUT_INTERVAL);
-    uint32_t *interval_list = create_uint32_array(size, 0);
-    uint32_t index = 0;
+    uint32_t n_proc = 0;
     uint32_t sum = 0, smallest = UINT32_MAX, biggest = 0, avg = 0;
 
-    //Calculate number of processes for each interval
-    for (struct process_t *curr = log->finished_process; curr != NULL; curr=curr->next)
-    {
-        if (curr->time_finished % THROUGHPUT_INTERVAL == 0)
-        {
-            index = ((uint32_t) ceil((curr->time_finished - 10) / THROUGHPUT_INTERVAL));
-        }
-        else
-        {
-            index = ((uint32_t) ceil((curr->time_finished - 1) / THROUGHPUT_INTERVAL));
-        }
-        interval_list[index] += 1;
-    }
-
     //Calculate throughput metrics
     for (uint32_t i = 0; i < size; i++)
     {
+        n_proc = i < log->n_intervals ? log->interval_list[i] : 0;
+
         //Store sum for average
-        sum += interval_list[i];
+        sum += n_proc;
 
         //Find minimum number of processes per interval
-        if (interval_list[i] < smallest)
+        if (n_proc < smallest)
         {
-            smallest = interval_list[i];
+            smallest = n_proc;
         }
 
         //Find maximum number of processes per interval
-        if (interval_list[i] > biggest)
+        if (n_proc > biggest)
         {
-            biggest = interval_list[i];
+            biggest = n_proc;
         }
     }
 
@@ -270,45 +366,11 @@ uint32_t *, [max, average]
 double *get_overhead(struct datalog_t *log)
 {
     double *ret_val = NULL;
-    double *overhead_list = malloc(sizeof(double) * log->n_proc_fin);
-    double turnaround_time = 0.0f, avg = 0.0f, sum = 0.0f, biggest = 0.0f;
-    struct process_t *curr = log->finished_process;
-
-    if (!overhead_list)
-    {
-        fprintf(stderr, "Malloc failed!\n");
-        exit(1);
-    }
-
-    for (uint32_t i = 0; i < log->n_proc_fin; i++)
-    {
-        overhead_list[i] = 0.0f;
-    }
-
-    //Calculate each process' overhead time
-    for (uint32_t i = 0; i < log->n_proc_fin; i++)
-    {
-        turnaround_time = curr->time_finished - curr->arrival_time;
-        overhead_list[i] =  turnaround_time / ((double)curr->job_time);
-        curr = curr->next;
-
-        //For calculating average overhead time
-        sum += overhead_list[i];
-
-        //Calculate maximum overhead time
-        if (overhead_list[i] > biggest)
-        {
-            biggest = overhead_list[i];
-        }
-    }
-
-    //Calculate average
-    avg = sum / log->n_proc_fin;
 
     //Package data for return
     ret_val = malloc(sizeof(double)*N_OVERHEAD_METRIC);
-    ret_val[0] = biggest;
-    ret_val[1] = avg;
+    ret_val[0] = log->max_overhead;
+    ret_val[1] = log->sum_overhead / log->n_proc_fin;
 
     return ret_val;
 }
@@ -339,87 +401,3 @@ uint32_t *create_uint32_array(uint32_t size, uint32_t init_value)
 
     return arr;
 }
-
-/*
-Reinitialises an existing uint32_t array
-@params
-array, uint32_t *, an already malloc-ed uint32_t array
-size, uint32_t, size of the new array
-init_value, uint32_t, initialising value of each entry in the array
-
-@return
-uint32_t *, the reinitialised array
-*/
-uint32_t *reinit_uint32_array(uint32_t *array, uint32_t size, uint32_t init_value)
-{
-    for (uint32_t i = 0; i < size; i++)
-    {
-        //Break out of loop if part of already initialised array has been reached
-        if(array[i] == init_value)
-        {
-            break;
-        }
-        array[i] = init_value;
-    }
-    return array;
-}
-
-/*
-Adds elements from array not in master, into master
-!! ASSUMES BOTH ARRAYS ARE SAME MAX LENGTH
-@params
-master, uint32_t, the array to append to, if any appends
-array, uint32_t, array to check 
-size, uint32_t, max elements of master
-
-@return
-uint32_t *, the modified master array
-*/
-uint32_t *add_to_array_nodup(uint32_t *master, uint32_t *array, uint32_t size)
-{
-    uint32_t *new_list = create_uint32_array(size, UINT32_MAX);
-    uint32_t count1 = 0, count2 = 0;
-
-    //Array empty
-    if (!array)
-    {
-        return master;
-    }
-
-    for (uint32_t i = 0; i < size; i++)
-    {
-        if (master[count1] == UINT32_MAX && array[count2] == UINT32_MAX)
-        {
-            break;
-        }
-        //master array is used up
-        else if (master[count1] == UINT32_MAX)
-        {
-            new_list[i] = array[count2];
-            count2 += 1;
-            continue;
-        }
-        //input array used up
-        else if (array[count2] == UINT32_MAX)
-        {
-            new_list[i] = master[count1];
-            count1 += 1;
-            continue;
-        }
-
-        //Sequential insert 
-        if (master[count1] < array[count2])
-        {
-            new_list[i] = master[count1];
-            count1 += 1;
-        }
-        else
-        {
-            new_list[i] = array[count2];
-            count2 += 1;
-        }
-    
-    }
-
-    return new_list;
-}
@@ -0,0 +1,508 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "../include/writer.h"
+#include "../include/ring.h"
+
+//Constants
+#define MAX_UINT32_DIGITS 10
+#define N_FORMATS 3
+#define SIZE_ADDR_BATCH 256
+#define N_EVENT_WORDS (sizeof(struct log_event_t) / sizeof(uint32_t))
+#define CSV_HEADER "time,event,id,remaining_time,load_time,mem_usage,proc_remaining,mem_addresses\n"
+
+char *format_names[N_FORMATS] = {"text", "csv", "jsonl"};
+char *event_names[] = {"RUNNING", "EVICTED", "FINISHED"};
+
+//Every two digit pair, so integers are formatted two digits per step
+const char digit_pairs[] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+//Functions
+void write_all(int, const char *, size_t);
+void *writer_thread(void *);
+int has_address_list(struct log_event_t *);
+void format_event_start(struct writer_t *, struct log_event_t *);
+void format_address(struct writer_t *, struct log_event_t *, uint32_t, uint32_t);
+void format_event_end(struct writer_t *, struct log_event_t *);
+
+/*
+Opens a writer that buffers formatted output and writes it to a file descriptor in large chunks
+!! THE FILE DESCRIPTOR IS NOT CLOSED WHEN THE WRITER IS CLOSED
+@params
+fd, int, the file descriptor to write to
+format, int, FORMAT_TEXT, FORMAT_CSV or FORMAT_JSONL for transcript events
+
+@return
+struct writer_t *, the opened writer
+*/
+struct writer_t *open_writer(int fd, int format)
+{
+    struct writer_t *writer = malloc(sizeof(struct writer_t));
+
+    if (!writer)
+    {
+        fprintf(stderr, "Malloc failed!\n");
+        exit(1);
+    }
+
+    writer->buffer = malloc(SIZE_WRITER_BUFFER);
+
+    if (!writer->buffer)
+    {
+        fprintf(stderr, "Malloc failed!\n");
+        exit(1);
+    }
+
+    writer->fd = fd;
+    writer->format = format;
+    writer->size = 0;
+    writer->ring = NULL;
+
+    if (format == FORMAT_CSV)
+    {
+        writer_put_str(writer, CSV_HEADER);
+    }
+
+    return writer;
+}
+
+/*
+Finds a transcript format by its command line name
+@params
+name, char *, one of text, csv or jsonl
+
+@return
+int, the format, -1 if unknown
+*/
+int find_format(char *name)
+{
+    for (int i = 0; i < N_FORMATS; i++)
+    {
+        if (strcmp(name, format_names[i]) == 0)
+        {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+/*
+Moves formatting and writing onto a dedicated thread, events are then only copied into
+a ring buffer by the caller of write_event
+!! write_event MUST ONLY BE CALLED FROM ONE THREAD ONCE STARTED
+@params
+writer, struct writer_t *, the writer, nothing should be buffered yet other than a header
+*/
+void start_writer_thread(struct writer_t *writer)
+{
+    writer->ring = init_ring(RING_CAPACITY_LOG2);
+
+    if (pthread_create(&writer->thread, NULL, writer_thread, writer) != 0)
+    {
+        fprintf(stderr, "Unable to create writer thread!\n");
+        exit(1);
+    }
+}
+
+/*
+Writes a transcript event, formatted right away or pushed to the writer thread
+@params
+writer, struct writer_t *, the writer
+event, struct log_event_t *, the event
+mem_address, const uint32_t *, the event's n_mem_addr memory addresses
+*/
+void write_event(struct writer_t *writer, struct log_event_t *event, const uint32_t *mem_address)
+{
+    //Only blocks if the writer thread has fallen a whole ring behind
+    if (writer->ring)
+    {
+        ring_push(writer->ring, (const uint32_t *)event, N_EVENT_WORDS);
+        ring_push(writer->ring, mem_address, event->n_mem_addr);
+        return;
+    }
+
+    format_event_start(writer, event);
+    for (uint32_t i = 0; i < event->n_mem_addr; i++)
+    {
+        format_address(writer, event, i, mem_address[i]);
+    }
+    format_event_end(writer, event);
+}
+
+/*
+Writer thread, formats events from the ring until it is closed and drained
+@params
+arg, void *, the writer
+
+@return
+void *, NULL
+*/
+void *writer_thread(void *arg)
+{
+    struct writer_t *writer = arg;
+    struct log_event_t event;
+    uint32_t mem_address[SIZE_ADDR_BATCH];
+
+    while (ring_pop(writer->ring, (uint32_t *)&event, N_EVENT_WORDS) == N_EVENT_WORDS)
+    {
+        format_event_start(writer, &event);
+
+        //Addresses are popped in batches, a record may be longer than the ring
+        for (uint32_t i = 0; i < event.n_mem_addr; )
+        {
+            uint32_t n = event.n_mem_addr - i < SIZE_ADDR_BATCH ? event.n_mem_addr - i : SIZE_ADDR_BATCH;
+
+            ring_pop(writer->ring, mem_address, n);
+            for (uint32_t j = 0; j < n; j++)
+            {
+                format_address(writer, &event, i + j, mem_address[j]);
+            }
+            i += n;
+        }
+        format_event_end(writer, &event);
+    }
+
+    return NULL;
+}
+
+/*
+Checks if an event lists memory addresses
+@params
+event, struct log_event_t *, the event
+
+@return
+int, 1 if it does, 0 otherwise
+*/
+int has_address_list(struct log_event_t *event)
+{
+    return event->type == LOG_EVICTED || (event->type == LOG_RUNNING && !event->flag_unlimited);
+}
+
+/*
+Formats everything of an event before its memory addresses
+!! THE TEXT FORMAT IS THE TRANSCRIPT AS LISTED IN PROJECT SPECS, INCLUDING WHICH FIELDS
+!! ARE PRINTED AS SIGNED
+@params
+writer, struct writer_t *, the writer
+event, struct log_event_t *, the event
+*/
+void format_event_start(struct writer_t *writer, struct log_event_t *event)
+{
+    if (writer->format == FORMAT_TEXT)
+    {
+        writer_put_uint(writer, event->cpu_clock);
+        writer_put_str(writer, ", ");
+        writer_put_str(writer, event_names[event->type]);
+
+        if (event->type == LOG_RUNNING && event->flag_unlimited)
+        {
+            writer_put_str(writer, ", id=");
+            writer_put_int(writer, event->pid);
+            writer_put_str(writer, ", remaining-time=");
+            writer_put_int(writer, event->time_required);
+        }
+        else if (event->type == LOG_RUNNING)
+        {
+            writer_put_str(writer, ", id=");
+            writer_put_uint(writer, event->pid);
+            writer_put_str(writer, ", remaining-time=");
+            writer_put_uint(writer, event->time_required);
+            writer_put_str(writer, ", load-time=");
+            writer_put_uint(writer, event->load_time);
+            writer_put_str(writer, ", mem-usage=");
+            writer_put_int(writer, event->mem_usage);
+            writer_put_str(writer, "%, mem-addresses=[");
+        }
+        else if (event->type == LOG_EVICTED)
+        {
+            writer_put_str(writer, ", mem-addresses=[");
+        }
+        else
+        {
+            writer_put_str(writer, ", id=");
+            writer_put_uint(writer, event->pid);
+            writer_put_str(writer, ", proc-remaining=");
+            writer_put_uint(writer, event->proc_remaining);
+        }
+    }
+    else if (writer->format == FORMAT_CSV)
+    {
+        int limited_run = (event->type == LOG_RUNNING && !event->flag_unlimited);
+
+        writer_put_uint(writer, event->cpu_clock);
+        writer_put_char(writer, ',');
+        writer_put_str(writer, event_names[event->type]);
+        writer_put_char(writer, ',');
+        if (event->type != LOG_EVICTED)
+        {
+            writer_put_uint(writer, event->pid);
+        }
+        writer_put_char(writer, ',');
+        if (event->type == LOG_RUNNING)
+        {
+            writer_put_uint(writer, event->time_required);
+        }
+        writer_put_char(writer, ',');
+        if (limited_run)
+        {
+            writer_put_uint(writer, event->load_time);
+        }
+        writer_put_char(writer, ',');
+        if (limited_run)
+        {
+            writer_put_uint(writer, event->mem_usage);
+        }
+        writer_put_char(writer, ',');
+        if (event->type == LOG_FINISHED)
+        {
+            writer_put_uint(writer, event->proc_remaining);
+        }
+        writer_put_char(writer, ',');
+    }
+    else
+    {
+        writer_put_str(writer, "{\"time\":");
+        writer_put_uint(writer, event->cpu_clock);
+        writer_put_str(writer, ",\"event\":\"");
+        writer_put_str(writer, event_names[event->type]);
+        writer_put_char(writer, '"');
+
+        if (event->type != LOG_EVICTED)
+        {
+            writer_put_str(writer, ",\"id\":");
+            writer_put_uint(writer, event->pid);
+        }
+        if (event->type == LOG_RUNNING)
+        {
+            writer_put_str(writer, ",\"remaining_time\":");
+            writer_put_uint(writer, event->time_required);
+        }
+        if (event->type == LOG_RUNNING && !event->flag_unlimited)
+        {
+            writer_put_str(writer, ",\"load_time\":");
+            writer_put_uint(writer, event->load_time);
+            writer_put_str(writer, ",\"mem_usage\":");
+            writer_put_uint(writer, event->mem_usage);
+        }
+        if (event->type == LOG_FINISHED)
+        {
+            writer_put_str(writer, ",\"proc_remaining\":");
+            writer_put_uint(writer, event->proc_remaining);
+        }
+        if (has_address_list(event))
+        {
+            writer_put_str(writer, ",\"mem_addresses\":[");
+        }
+    }
+}
+
+/*
+Formats one memory address of an event
+@params
+writer, struct writer_t *, the writer
+event, struct log_event_t *, the event
+i, uint32_t, index of the address within the event
+mem_address, uint32_t, the address
+*/
+void format_address(struct writer_t *writer, struct log_event_t *event, uint32_t i, uint32_t mem_address)
+{
+    if (i > 0)
+    {
+        writer_put_char(writer, writer->format == FORMAT_CSV ? ' ' : ',');
+    }
+
+    //The text transcript prints every EVICTED address but the first as signed
+    if (writer->format == FORMAT_TEXT && event->type == LOG_EVICTED && i > 0)
+    {
+        writer_put_int(writer, mem_address);
+        return;
+    }
+    writer_put_uint(writer, mem_address);
+}
+
+/*
+Formats everything of an event after its memory addresses
+@params
+writer, struct writer_t *, the writer
+event, struct log_event_t *, the event
+*/
+void format_event_end(struct writer_t *writer, struct log_event_t *event)
+{
+    if (writer->format == FORMAT_TEXT && has_address_list(event))
+    {
+        writer_put_char(writer, ']');
+    }
+    else if (writer->format == FORMAT_JSONL)
+    {
+        writer_put_str(writer, has_address_list(event) ? "]}" : "}");
+    }
+    writer_put_char(writer, '\n');
+}
+
+/*
+Appends a string to the writer's buffer
+@params
+writer, struct writer_t *, the writer
+str, const char *, the string
+*/
+void writer_put_str(struct writer_t *writer, const char *str)
+{
+    size_t len = strlen(str);
+
+    if (writer->size + len > SIZE_WRITER_BUFFER)
+    {
+        flush_writer(writer);
+
+        //Too long to ever be buffered
+        if (len > SIZE_WRITER_BUFFER)
+        {
+            write_all(writer->fd, str, len);
+            return;
+        }
+    }
+
+    memcpy(writer->buffer + writer->size, str, len);
+    writer->size += len;
+}
+
+/*
+Appends a character to the writer's buffer
+@params
+writer, struct writer_t *, the writer
+c, char, the character
+*/
+void writer_put_char(struct writer_t *writer, char c)
+{
+    if (writer->size == SIZE_WRITER_BUFFER)
+    {
+        flush_writer(writer);
+    }
+
+    writer->buffer[writer->size++] = c;
+}
+
+/*
+Formats an unsigned integer in decimal straight into the writer's buffer
+@params
+writer, struct writer_t *, the writer
+value, uint32_t, the integer
+*/
+void writer_put_uint(struct writer_t *writer, uint32_t value)
+{
+    char digits[MAX_UINT32_DIGITS];
+    char *curr = digits + MAX_UINT32_DIGITS;
+    size_t len = 0;
+
+    //Fill from the least significant digits, two at a time
+    while (value >= 100)
+    {
+        const char *pair = digit_pairs + (value % 100) * 2;
+
+        value /= 100;
+        curr -= 2;
+        curr[0] = pair[0];
+        curr[1] = pair[1];
+    }
+    if (value >= 10)
+    {
+        curr -= 2;
+        curr[0] = digit_pairs[value * 2];
+        curr[1] = digit_pairs[value * 2 + 1];
+    }
+    else
+    {
+        *--curr = '0' + value;
+    }
+
+    len = digits + MAX_UINT32_DIGITS - curr;
+
+    if (writer->size + len > SIZE_WRITER_BUFFER)
+    {
+        flush_writer(writer);
+    }
+
+    memcpy(writer->buffer + writer->size, curr, len);
+    writer->size += len;
+}
+
+/*
+Formats a signed integer in decimal straight into the writer's buffer
+@params
+writer, struct writer_t *, the writer
+value, int32_t, the integer
+*/
+void writer_put_int(struct writer_t *writer, int32_t value)
+{
+    if (value < 0)
+    {
+        writer_put_char(writer, '-');
+        writer_put_uint(writer, -(uint32_t)value);
+        return;
+    }
+
+    writer_put_uint(writer, value);
+}
+
+/*
+Writes out everything buffered so far
+@params
+writer, struct writer_t *, the writer
+*/
+void flush_writer(struct writer_t *writer)
+{
+    write_all(writer->fd, writer->buffer, writer->size);
+    writer->size = 0;
+}
+
+/*
+Writes a whole buffer to a file descriptor, retrying partial and interrupted writes
+@params
+fd, int, the file descriptor
+data, const char *, the buffer
+len, size_t, the number of bytes to write
+*/
+void write_all(int fd, const char *data, size_t len)
+{
+    while (len > 0)
+    {
+        ssize_t n_written = write(fd, data, len);
+
+        if (n_written < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            fprintf(stderr, "Unable to write transcript!\n");
+            exit(1);
+        }
+        data += n_written;
+        len -= n_written;
+    }
+}
+
+/*
+Flushes and frees a writer, waiting for the writer thread to format every pushed event
+@params
+writer, struct writer_t *, the writer
+*/
+void close_writer(struct writer_t *writer)
+{
+    if (writer->ring)
+    {
+        close_ring(writer->ring);
+        pthread_join(writer->thread, NULL);
+        free_ring(writer->ring);
+    }
+    flush_writer(writer);
+    free(writer->buffer);
+    free(writer);
+}